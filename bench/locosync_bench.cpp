@@ -0,0 +1,462 @@
+// Benchmarks reprodutíveis do Client contra um servidor HTTP/1.1 em loopback.
+//
+//   locosync_bench [cenário...] [--engine=threaded|reactor|all] [--scale=F]
+//                  [--reactor-threads=N] [--list]
+//
+// Para cada cenário e engine: req/s, latência p50/p99/p99.9 (da chamada até o
+// callback), erros, alocações C++ por requisição, pico de threads e de RSS.
+// decode_dom/decode_typed não usam a rede: comparam o parse de uma lista
+// grande em DOM com a decodificação direta em structs.
+#include "loopback_server.hpp"
+#include "locosync/locosync.hpp"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --- CONTADOR DE ALOCAÇÕES ---
+// operator new global: conta alocações C++ de todas as threads, exceto as
+// marcadas (servidor e amostrador). Alocações internas do cURL usam malloc.
+// Todas as formas (escalar, array, nothrow, alinhada) são substituídas, com os
+// deletes correspondentes: cada alocação é liberada pelo par dela.
+
+namespace {
+std::atomic<std::uint64_t> allocations{0};
+thread_local bool untracked = false;
+
+void* allocate(std::size_t size) noexcept {
+    if (!untracked) allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* allocate_aligned(std::size_t size, std::align_val_t align) noexcept {
+    if (!untracked) allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = nullptr;
+    const auto alignment = std::max(static_cast<std::size_t>(align), sizeof(void*));
+    return posix_memalign(&p, alignment, size ? size : 1) == 0 ? p : nullptr;
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = allocate_aligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = allocate_aligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, align);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using locosync::bench::LoopbackServer;
+
+// --- MEDIÇÕES DO PROCESSO ---
+
+// Campo numérico de /proc/self/status (Linux); -1 se indisponível
+long proc_status(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const std::string prefix = std::string(field) + ":";
+    while (std::getline(status, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) return std::atol(line.c_str() + prefix.size());
+    }
+    return -1;
+}
+
+// Zera o pico de RSS (VmHWM) para medir cada cenário separadamente (Linux >= 4.0)
+void reset_peak_rss() {
+    std::ofstream clear("/proc/self/clear_refs");
+    if (clear) clear << "5";
+}
+
+long peak_rss_kb() {
+    const long hwm = proc_status("VmHWM");
+    if (hwm >= 0) return hwm;
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Pico de threads do processo enquanto o cenário roda
+class ThreadSampler {
+public:
+    ThreadSampler() {
+        worker = std::thread([this] {
+            untracked = true;
+            while (!stop.load(std::memory_order_relaxed)) {
+                peak_threads = std::max(peak_threads.load(), proc_status("Threads"));
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+    }
+    ~ThreadSampler() {
+        stop = true;
+        worker.join();
+    }
+    long peak() const { return peak_threads.load(); }
+
+private:
+    std::atomic<bool> stop{false};
+    std::atomic<long> peak_threads{-1};
+    std::thread worker;
+};
+
+// --- CENÁRIOS ---
+
+// Documento de /json decodificado com Response::as<T>()
+struct Item {
+    std::uint64_t id{0};
+    std::string name;
+    double price{0.0};
+    bool active{false};
+    std::vector<std::string> tags;
+};
+LOCOSYNC_FIELDS(Item, id, name, price, active, tags)
+
+struct ItemPage {
+    std::size_t count{0};
+    std::vector<Item> items;
+};
+LOCOSYNC_FIELDS(ItemPage, count, items)
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    std::size_t requests;
+    std::size_t concurrency;
+    std::function<locosync::Request()> make;
+    std::function<bool(const locosync::Response&)> check;
+    // Cenário sem rede (engine "-"): cada "requisição" é uma chamada
+    std::function<bool()> offline{};
+};
+
+std::vector<Scenario> make_scenarios(const LoopbackServer& server, const std::string& upload,
+                                     const std::string& document) {
+    using locosync::Method;
+    using locosync::Request;
+    using locosync::Response;
+
+    auto get = [&server](const std::string& path) {
+        return [url = server.url(path)] {
+            Request r;
+            r.url = url;
+            return r;
+        };
+    };
+    auto body_size = [](std::size_t size) {
+        return [size](const Response& res) { return res.ok() && res.body.size() == size; };
+    };
+
+    constexpr std::size_t kLarge = 16 * 1024 * 1024;
+    constexpr std::size_t kDocumentItems = 10000;
+
+    return {
+        {"small_get", "GET de 128 bytes, keep-alive", 20000, 32, get("/bytes?size=128"), body_size(128)},
+        {"small_get_close", "GET de 128 bytes, Connection: close", 5000, 16, get("/bytes?size=128&close=1"),
+         body_size(128)},
+        {"large_body", "GET de 16 MiB", 64, 4, get("/bytes?size=" + std::to_string(kLarge)), body_size(kLarge)},
+        {"large_upload", "POST de 16 MiB (Body::borrow)", 64, 4,
+         [url = server.url("/upload"), &upload] {
+             Request r;
+             r.url = url;
+             r.method = Method::POST;
+             r.headers["Content-Type"] = "application/octet-stream";
+             r.body = locosync::Body::borrow(upload);
+             return r;
+         },
+         [size = upload.size()](const Response& res) {
+             return res.ok() && res.body == "{\"received\":" + std::to_string(size) + "}";
+         }},
+        {"high_concurrency", "1000 GETs em voo, resposta após 20 ms", 20000, 1000,
+         get("/bytes?size=512&delay_ms=20"), body_size(512)},
+        {"json", "GET de JSON com 1000 objetos + Response::json_ref()", 2000, 16, get("/json?items=1000"),
+         [](const Response& res) { return res.ok() && res.json_ref().value("count", 0) == 1000; }},
+        {"json_typed", "GET de JSON com 1000 objetos + Response::as<T>()", 2000, 16, get("/json?items=1000"),
+         [](const Response& res) {
+             if (!res.ok()) return false;
+             const auto page = res.try_as<ItemPage>();
+             return page && page->count == 1000 && page->items.size() == 1000;
+         }},
+        {"decode_dom", "parse de lista com 10000 objetos em nlohmann::json (DOM)", 100, 1, {}, {},
+         [&document] {
+             const auto doc = nlohmann::json::parse(document);
+             return doc.value("count", 0u) == kDocumentItems && doc.at("items").size() == kDocumentItems;
+         }},
+        {"decode_typed", "mesma lista decodificada direto em structs (SAX)", 100, 1, {}, {},
+         [&document] {
+             const auto page = locosync::try_decode_json<ItemPage>(document);
+             return page && page->count == kDocumentItems && page->items.size() == kDocumentItems;
+         }},
+    };
+}
+
+// --- EXECUÇÃO ---
+
+// Laço fechado: cada resposta dispara a próxima requisição, mantendo
+// `concurrency` em voo até completar o total
+struct Run {
+    locosync::Client* client{nullptr};
+    const Scenario* scenario{nullptr};
+    std::size_t total{0};
+
+    std::vector<Clock::time_point> started;
+    std::vector<double> latencies; // segundos
+    std::atomic<std::size_t> issued{0};
+    std::atomic<std::size_t> completed{0};
+    std::atomic<std::size_t> errors{0};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    bool finished{false};
+    std::string first_error;
+
+    void issue();
+    void complete(std::size_t index, const locosync::Response& res);
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finished; });
+    }
+};
+
+void Run::issue() {
+    const std::size_t index = issued.fetch_add(1, std::memory_order_relaxed);
+    if (index >= total) return;
+    started[index] = Clock::now();
+    // Captura de 16 bytes: cabe no buffer interno do std::function (sem alocar)
+    client->request(scenario->make(), [this, index](locosync::Response res) { complete(index, res); });
+}
+
+void Run::complete(std::size_t index, const locosync::Response& res) {
+    latencies[index] = std::chrono::duration<double>(Clock::now() - started[index]).count();
+    if (!scenario->check(res)) {
+        if (errors.fetch_add(1, std::memory_order_relaxed) == 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            first_error = res.error_message.empty() ? "HTTP " + std::to_string(res.status_code) : res.error_message;
+        }
+    }
+    issue();
+    if (completed.fetch_add(1, std::memory_order_acq_rel) + 1 == total) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        done.notify_all();
+    }
+}
+
+void drive(locosync::Client& client, const Scenario& scenario, Run& run, std::size_t total) {
+    run.client = &client;
+    run.scenario = &scenario;
+    run.total = total;
+    run.started.resize(total);
+    run.latencies.resize(total);
+    const std::size_t window = std::min(scenario.concurrency, total);
+    for (std::size_t i = 0; i < window; ++i) run.issue();
+    if (total > 0) run.wait();
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size()));
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void print_row(const Scenario& scenario, const char* engine, std::size_t total, double seconds,
+               std::vector<double>& latencies, std::size_t errors, std::uint64_t allocs, long threads) {
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-18s %-9s %7zu %6zu %10.0f %9.3f %9.3f %9.3f %7zu %11.1f %8ld %9.1f\n", scenario.name, engine,
+                total, scenario.concurrency, static_cast<double>(total) / seconds, percentile(latencies, 0.50) * 1e3,
+                percentile(latencies, 0.99) * 1e3, percentile(latencies, 0.999) * 1e3, errors,
+                static_cast<double>(allocs) / static_cast<double>(total), threads,
+                static_cast<double>(peak_rss_kb()) / 1024.0);
+}
+
+// Cenário sem rede: chamadas em sequência na thread principal
+bool run_offline(const Scenario& scenario, double scale) {
+    const std::size_t total = std::max<std::size_t>(1, static_cast<std::size_t>(scenario.requests * scale));
+    scenario.offline(); // aquecimento
+
+    reset_peak_rss();
+    std::vector<double> latencies(total);
+    std::size_t errors = 0;
+    const std::uint64_t allocs_before = allocations.load();
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < total; ++i) {
+        const auto t0 = Clock::now();
+        if (!scenario.offline()) ++errors;
+        latencies[i] = std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const std::uint64_t allocs = allocations.load() - allocs_before;
+
+    print_row(scenario, "-", total, seconds, latencies, errors, allocs, 1);
+    std::fflush(stdout);
+    return errors == 0;
+}
+
+// Retorna false se alguma resposta falhou na verificação do cenário
+bool run_scenario(const Scenario& scenario, locosync::Engine engine, std::size_t reactor_threads, double scale) {
+    locosync::ClientOptions options;
+    options.engine = engine;
+    options.reactor_threads = reactor_threads;
+    auto client = locosync::Client::create(options);
+
+    const std::size_t total = std::max<std::size_t>(1, static_cast<std::size_t>(scenario.requests * scale));
+
+    // Aquecimento: abre as conexões antes de medir
+    {
+        Run warmup;
+        drive(*client, scenario, warmup, std::min(total, scenario.concurrency));
+    }
+
+    reset_peak_rss();
+    Run run;
+    run.started.reserve(total);
+    run.latencies.reserve(total);
+
+    std::uint64_t allocs_before = 0;
+    double seconds = 0.0;
+    long threads = -1;
+    {
+        ThreadSampler sampler;
+        allocs_before = allocations.load();
+        const auto start = Clock::now();
+        drive(*client, scenario, run, total);
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        // Sem o amostrador e a thread do servidor
+        threads = sampler.peak() > 0 ? sampler.peak() - 2 : -1;
+    }
+    const std::uint64_t allocs = allocations.load() - allocs_before;
+
+    print_row(scenario, engine == locosync::Engine::Reactor ? "reactor" : "threaded", total, seconds, run.latencies,
+              run.errors.load(), allocs, threads);
+    if (!run.first_error.empty()) std::printf("  primeiro erro: %s\n", run.first_error.c_str());
+    std::fflush(stdout);
+    return run.errors.load() == 0;
+}
+
+// Conexões do cliente e do servidor no mesmo processo: 1000 em voo = 2000 fds
+void raise_fd_limit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::signal(SIGPIPE, SIG_IGN);
+    raise_fd_limit();
+
+    std::vector<std::string> selected;
+    std::vector<locosync::Engine> engines{locosync::Engine::Threaded, locosync::Engine::Reactor};
+    double scale = 1.0;
+    std::size_t reactor_threads = 1;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--list") {
+            list = true;
+        } else if (arg == "--engine=threaded") {
+            engines = {locosync::Engine::Threaded};
+        } else if (arg == "--engine=reactor") {
+            engines = {locosync::Engine::Reactor};
+        } else if (arg == "--engine=all") {
+            engines = {locosync::Engine::Threaded, locosync::Engine::Reactor};
+        } else if (arg.rfind("--scale=", 0) == 0) {
+            scale = std::atof(arg.c_str() + 8);
+        } else if (arg.rfind("--reactor-threads=", 0) == 0) {
+            reactor_threads = static_cast<std::size_t>(std::atol(arg.c_str() + 18));
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Opção desconhecida: " << arg << "\n";
+            return 2;
+        } else {
+            selected.push_back(arg);
+        }
+    }
+    if (scale <= 0.0) scale = 1.0;
+
+    locosync::bench::LoopbackOptions server_options;
+    server_options.on_thread_start = [] { untracked = true; };
+    LoopbackServer server(server_options);
+
+    const std::string upload(16 * 1024 * 1024, 'u');
+    const std::string document = locosync::bench::make_json(10000);
+    const auto scenarios = make_scenarios(server, upload, document);
+
+    if (list) {
+        for (const auto& s : scenarios) std::printf("%-18s %s\n", s.name, s.description);
+        return 0;
+    }
+
+    std::printf("LocoSync %s | servidor em %s | escala %.2f\n", LOCOSYNC_VERSION, server.url("").c_str(), scale);
+    std::printf("%-18s %-9s %7s %6s %10s %9s %9s %9s %7s %11s %8s %9s\n", "cenário", "engine", "reqs", "conc",
+                "req/s", "p50 ms", "p99 ms", "p99.9 ms", "erros", "allocs/req", "threads", "RSS MiB");
+
+    bool any = false;
+    bool ok = true;
+    for (const auto& scenario : scenarios) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), scenario.name) == selected.end()) continue;
+        any = true;
+        if (scenario.offline) {
+            ok = run_offline(scenario, scale) && ok;
+            continue;
+        }
+        for (auto engine : engines) ok = run_scenario(scenario, engine, reactor_threads, scale) && ok;
+    }
+    if (!any) {
+        std::cerr << "Nenhum cenário corresponde; use --list\n";
+        return 2;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,486 @@
+#include "loopback_server.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: o bench ignora SIGPIPE
+#endif
+
+namespace locosync::bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kMaxHeaderBytes = 64 * 1024;
+
+// Corpo de /bytes: o mesmo bloco é reenviado até completar o tamanho pedido,
+// então respostas grandes não ocupam memória no processo do benchmark
+const std::string& filler() {
+    static const std::string block(64 * 1024, 'x');
+    return block;
+}
+
+void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+std::uint64_t to_number(std::string_view text, std::uint64_t fallback) {
+    std::uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size() ? value : fallback;
+}
+
+// Valor numérico de `name` na query string
+std::uint64_t query_param(std::string_view query, std::string_view name, std::uint64_t fallback) {
+    while (!query.empty()) {
+        const std::size_t amp = query.find('&');
+        std::string_view pair = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view{} : query.substr(amp + 1);
+
+        const std::size_t eq = pair.find('=');
+        if (eq != std::string_view::npos && pair.substr(0, eq) == name) {
+            return to_number(pair.substr(eq + 1), fallback);
+        }
+    }
+    return fallback;
+}
+
+enum class State { Headers, Body, Waiting, Writing };
+
+struct Connection {
+    int fd{-1};
+    State state{State::Headers};
+    bool closed{false};
+
+    std::string in; // headers ainda incompletos (ou bytes adiantados)
+
+    // Requisição atual
+    std::string_view route;
+    std::string query;
+    std::uint64_t body_remaining{0};
+    std::uint64_t body_received{0};
+    bool close_after{false};
+    bool unsupported{false};
+    std::string echo_body;     // /echo: corpo recebido, devolvido sem alteração
+    std::string echo_type;
+    std::string echo_encoding;
+    Clock::time_point ready_at;
+
+    // Resposta: head + payload fixo ou `filler_remaining` bytes de filler()
+    std::string head;
+    std::size_t head_sent{0};
+    std::string_view payload;
+    std::size_t payload_sent{0};
+    std::uint64_t filler_remaining{0};
+    std::size_t filler_offset{0};
+};
+
+// Estado da thread do servidor (só ela toca nos objetos abaixo)
+struct ServerLoop {
+    const LoopbackOptions& options;
+    std::atomic<std::uint64_t>& served;
+    std::vector<std::unique_ptr<Connection>> connections;
+    std::map<std::uint64_t, std::string> json_documents;
+
+    void close(Connection& c) {
+        if (c.closed) return;
+        ::close(c.fd);
+        c.closed = true;
+    }
+
+    void feed(Connection& c, std::string_view data);
+    void parse_request(Connection& c, std::string_view head);
+    void respond(Connection& c);
+    void flush(Connection& c);
+};
+
+void ServerLoop::feed(Connection& c, std::string_view data) {
+    std::string rest;
+    while (!data.empty() && !c.closed) {
+        if (c.state == State::Body) {
+            const auto take = static_cast<std::size_t>(std::min<std::uint64_t>(c.body_remaining, data.size()));
+            if (c.route == "/echo") c.echo_body.append(data.substr(0, take));
+            c.body_remaining -= take;
+            c.body_received += take;
+            data.remove_prefix(take);
+            if (c.body_remaining == 0) respond(c);
+            continue;
+        }
+        if (c.state != State::Headers) {
+            // Próxima requisição chegou antes da resposta atual sair
+            c.in.append(data);
+            return;
+        }
+
+        c.in.append(data);
+        const std::size_t end = c.in.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            if (c.in.size() > kMaxHeaderBytes) close(c);
+            return;
+        }
+        rest.assign(c.in, end + 4);
+        parse_request(c, std::string_view(c.in).substr(0, end));
+        c.in.clear();
+        data = rest;
+        if (c.state == State::Body && c.body_remaining == 0) respond(c);
+    }
+}
+
+void ServerLoop::parse_request(Connection& c, std::string_view head) {
+    const std::size_t line_end = head.find("\r\n");
+    std::string_view line = head.substr(0, line_end);
+    head = line_end == std::string_view::npos ? std::string_view{} : head.substr(line_end + 2);
+
+    // "METHOD /path?query HTTP/1.1"
+    const std::size_t sp1 = line.find(' ');
+    const std::size_t sp2 = line.find(' ', sp1 + 1);
+    std::string_view target = sp1 == std::string_view::npos ? std::string_view{} : line.substr(sp1 + 1, sp2 - sp1 - 1);
+    const std::size_t qmark = target.find('?');
+    const std::string_view path = target.substr(0, qmark);
+    c.query.assign(qmark == std::string_view::npos ? std::string_view{} : target.substr(qmark + 1));
+
+    if (path == "/bytes") c.route = "/bytes";
+    else if (path == "/json") c.route = "/json";
+    else if (path == "/upload") c.route = "/upload";
+    else if (path == "/echo") c.route = "/echo";
+    else c.route = {};
+
+    c.body_remaining = 0;
+    c.body_received = 0;
+    c.unsupported = false;
+    c.echo_body.clear();
+    c.echo_type.clear();
+    c.echo_encoding.clear();
+    c.close_after = !options.keep_alive || query_param(c.query, "close", 0) != 0;
+    bool expect_continue = false;
+
+    while (!head.empty()) {
+        const std::size_t eol = head.find("\r\n");
+        std::string_view header = head.substr(0, eol);
+        head = eol == std::string_view::npos ? std::string_view{} : head.substr(eol + 2);
+
+        const std::size_t colon = header.find(':');
+        if (colon == std::string_view::npos) continue;
+        const std::string_view name = trim(header.substr(0, colon));
+        const std::string_view value = trim(header.substr(colon + 1));
+
+        if (iequals(name, "content-length")) c.body_remaining = to_number(value, 0);
+        else if (iequals(name, "connection") && iequals(value, "close")) c.close_after = true;
+        else if (iequals(name, "expect") && iequals(value, "100-continue")) expect_continue = true;
+        else if (iequals(name, "content-type")) c.echo_type.assign(value);
+        else if (iequals(name, "content-encoding")) c.echo_encoding.assign(value);
+        else if (iequals(name, "transfer-encoding")) {
+            // Upload chunked não é suportado: responde e fecha
+            c.unsupported = true;
+            c.close_after = true;
+        }
+    }
+
+    if (expect_continue && c.body_remaining > 0) {
+        static constexpr char kContinue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+        ::send(c.fd, kContinue, sizeof(kContinue) - 1, MSG_NOSIGNAL);
+    }
+    c.state = State::Body;
+}
+
+void ServerLoop::respond(Connection& c) {
+    std::string_view content_type = "application/octet-stream";
+    int status = 200;
+    std::uint64_t content_length = 0;
+
+    c.payload = {};
+    c.payload_sent = 0;
+    c.filler_remaining = 0;
+    c.filler_offset = 0;
+    c.head_sent = 0;
+
+    std::string body_inline;
+    if (c.unsupported) {
+        status = 501;
+    } else if (c.route == "/bytes") {
+        c.filler_remaining = query_param(c.query, "size", 0);
+        content_length = c.filler_remaining;
+    } else if (c.route == "/json") {
+        const std::uint64_t items = query_param(c.query, "items", 100);
+        auto it = json_documents.find(items);
+        if (it == json_documents.end()) it = json_documents.emplace(items, make_json(items)).first;
+        c.payload = it->second;
+        content_type = "application/json";
+        content_length = c.payload.size();
+    } else if (c.route == "/upload") {
+        body_inline = "{\"received\":" + std::to_string(c.body_received) + "}";
+        content_type = "application/json";
+        content_length = body_inline.size();
+    } else if (c.route == "/echo") {
+        c.payload = c.echo_body;
+        if (!c.echo_type.empty()) content_type = c.echo_type;
+        content_length = c.payload.size();
+    } else {
+        status = 404;
+    }
+
+    c.head.clear();
+    c.head += status == 200 ? "HTTP/1.1 200 OK\r\n" : status == 404 ? "HTTP/1.1 404 Not Found\r\n"
+                                                                   : "HTTP/1.1 501 Not Implemented\r\n";
+    c.head += "Content-Type: ";
+    c.head += content_type;
+    c.head += "\r\nContent-Length: " + std::to_string(content_length) + "\r\n";
+    if (c.route == "/echo" && !c.echo_encoding.empty()) c.head += "Content-Encoding: " + c.echo_encoding + "\r\n";
+    if (c.close_after) c.head += "Connection: close\r\n";
+    c.head += "\r\n";
+    c.head += body_inline;
+
+    const std::uint64_t delay_ms = query_param(c.query, "delay_ms", 0);
+    if (delay_ms > 0) {
+        c.ready_at = Clock::now() + std::chrono::milliseconds(delay_ms);
+        c.state = State::Waiting;
+        return;
+    }
+    c.state = State::Writing;
+    flush(c);
+}
+
+void ServerLoop::flush(Connection& c) {
+    while (!c.closed) {
+        iovec parts[2];
+        int count = 0;
+        if (c.head_sent < c.head.size()) {
+            parts[count++] = {c.head.data() + c.head_sent, c.head.size() - c.head_sent};
+        }
+        if (c.payload_sent < c.payload.size()) {
+            parts[count++] = {const_cast<char*>(c.payload.data()) + c.payload_sent, c.payload.size() - c.payload_sent};
+        } else if (c.filler_remaining > 0) {
+            const std::string& block = filler();
+            const std::size_t size = static_cast<std::size_t>(
+                std::min<std::uint64_t>(c.filler_remaining, block.size() - c.filler_offset));
+            parts[count++] = {const_cast<char*>(block.data()) + c.filler_offset, size};
+        }
+
+        if (count == 0) {
+            // Resposta completa
+            served.fetch_add(1, std::memory_order_relaxed);
+            if (c.close_after) {
+                close(c);
+                return;
+            }
+            c.state = State::Headers;
+            if (!c.in.empty()) {
+                std::string pending = std::move(c.in);
+                c.in.clear();
+                feed(c, pending);
+            }
+            return;
+        }
+
+        msghdr message{};
+        message.msg_iov = parts;
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+        const ssize_t sent = ::sendmsg(c.fd, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return; // espera POLLOUT
+            if (errno == EINTR) continue;
+            close(c);
+            return;
+        }
+
+        auto advance = static_cast<std::size_t>(sent);
+        const std::size_t from_head = std::min(advance, c.head.size() - c.head_sent);
+        c.head_sent += from_head;
+        advance -= from_head;
+        if (c.payload_sent < c.payload.size()) {
+            c.payload_sent += advance;
+        } else if (advance > 0) {
+            c.filler_remaining -= advance;
+            c.filler_offset = (c.filler_offset + advance) % filler().size();
+        }
+    }
+}
+
+} // namespace
+
+std::string make_json(std::uint64_t items) {
+    std::string out = "{\"count\":" + std::to_string(items) + ",\"items\":[";
+    for (std::uint64_t i = 0; i < items; ++i) {
+        if (i) out.push_back(',');
+        out += "{\"id\":" + std::to_string(i);
+        out += ",\"name\":\"item-" + std::to_string(i) + "\"";
+        out += ",\"price\":" + std::to_string(i % 1000) + ".25";
+        out += ",\"active\":";
+        out += (i % 3 ? "true" : "false");
+        out += ",\"tags\":[\"alpha\",\"beta\",\"gamma\"]}";
+    }
+    out += "]}";
+    return out;
+}
+
+// --- LoopbackServer ---
+
+LoopbackServer::LoopbackServer(LoopbackOptions opts) : options(std::move(opts)) {
+    listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) throw std::system_error(errno, std::generic_category(), "socket");
+
+    int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(options.port);
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listen_fd, SOMAXCONN) < 0) {
+        const int error = errno;
+        ::close(listen_fd);
+        throw std::system_error(error, std::generic_category(), "bind/listen 127.0.0.1");
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    bound_port = ntohs(addr.sin_port);
+    set_nonblocking(listen_fd);
+
+    if (::pipe(wake_pipe) < 0) {
+        const int error = errno;
+        ::close(listen_fd);
+        throw std::system_error(error, std::generic_category(), "pipe");
+    }
+
+    thread = std::thread([this] { run(); });
+}
+
+LoopbackServer::~LoopbackServer() {
+    const char stop = 1;
+    [[maybe_unused]] auto n = ::write(wake_pipe[1], &stop, 1);
+    if (thread.joinable()) thread.join();
+    ::close(wake_pipe[0]);
+    ::close(wake_pipe[1]);
+    ::close(listen_fd);
+}
+
+std::string LoopbackServer::url(std::string_view path) const {
+    return "http://127.0.0.1:" + std::to_string(bound_port) + std::string(path);
+}
+
+void LoopbackServer::run() {
+    if (options.on_thread_start) options.on_thread_start();
+
+    ServerLoop loop{options, served, {}, {}};
+    std::vector<pollfd> fds;
+    char buffer[64 * 1024];
+
+    for (;;) {
+        fds.clear();
+        fds.push_back({wake_pipe[0], POLLIN, 0});
+        fds.push_back({listen_fd, POLLIN, 0});
+
+        int timeout_ms = -1;
+        const auto now = Clock::now();
+        for (auto& c : loop.connections) {
+            short events = 0;
+            if (c->state == State::Headers || c->state == State::Body) events = POLLIN;
+            if (c->state == State::Writing) events = POLLOUT;
+            if (c->state == State::Waiting) {
+                const auto wait = std::chrono::ceil<std::chrono::milliseconds>(c->ready_at - now).count();
+                const int ms = static_cast<int>(std::max<decltype(wait)>(wait, 0));
+                timeout_ms = timeout_ms < 0 ? ms : std::min(timeout_ms, ms);
+            }
+            fds.push_back({c->fd, events, 0});
+        }
+
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout_ms) < 0 && errno != EINTR) break;
+        if (fds[0].revents) break;
+
+        // Conexões novas entram na próxima volta do poll
+        const std::size_t existing = loop.connections.size();
+        if (fds[1].revents & POLLIN) {
+            for (;;) {
+                const int fd = ::accept(listen_fd, nullptr, nullptr);
+                if (fd < 0) break;
+                accepted.fetch_add(1, std::memory_order_relaxed);
+                set_nonblocking(fd);
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                auto c = std::make_unique<Connection>();
+                c->fd = fd;
+                loop.connections.push_back(std::move(c));
+            }
+        }
+
+        const auto after_poll = Clock::now();
+        for (std::size_t i = 0; i < existing; ++i) {
+            Connection& c = *loop.connections[i];
+            const short revents = fds[i + 2].revents;
+
+            if (c.state == State::Waiting && after_poll >= c.ready_at) {
+                c.state = State::Writing;
+                loop.flush(c);
+                continue;
+            }
+            if (revents & (POLLERR | POLLNVAL)) {
+                loop.close(c);
+                continue;
+            }
+            if (c.state == State::Writing && (revents & POLLOUT)) {
+                loop.flush(c);
+                continue;
+            }
+            if (revents & (POLLIN | POLLHUP)) {
+                for (;;) {
+                    const ssize_t n = ::recv(c.fd, buffer, sizeof(buffer), 0);
+                    if (n > 0) {
+                        loop.feed(c, std::string_view(buffer, static_cast<std::size_t>(n)));
+                        if (c.closed || c.state == State::Writing || c.state == State::Waiting) break;
+                        continue;
+                    }
+                    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) loop.close(c);
+                    break;
+                }
+            }
+        }
+
+        // Remove as fechadas (troca com o último)
+        for (std::size_t i = 0; i < loop.connections.size();) {
+            if (loop.connections[i]->closed) {
+                loop.connections[i] = std::move(loop.connections.back());
+                loop.connections.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    for (auto& c : loop.connections) loop.close(*c);
+}
+
+} // namespace locosync::bench
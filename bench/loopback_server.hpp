@@ -0,0 +1,69 @@
+#ifndef LOCOSYNC_BENCH_LOOPBACK_SERVER_HPP
+#define LOCOSYNC_BENCH_LOOPBACK_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace locosync::bench {
+
+// Servidor HTTP/1.1 mínimo em 127.0.0.1 para os benchmarks: uma thread com
+// poll() e sockets não bloqueantes, sem dependências além de POSIX.
+//
+// Rotas (parâmetros na query string):
+//   GET  /bytes?size=N          N bytes de corpo
+//   GET  /json?items=N          documento JSON com N objetos
+//   POST /upload (ou PUT)       descarta o corpo e responde {"received":N}
+//   POST /echo (ou PUT)         devolve o corpo com os mesmos Content-Type e
+//                               Content-Encoding (sem descompactar)
+// Em todas: delay_ms=D atrasa a resposta sem bloquear a thread, e close=1
+// responde com "Connection: close".
+struct LoopbackOptions {
+    std::uint16_t port{0}; // 0 = porta efêmera
+
+    // false: toda resposta fecha a conexão (mede o custo de handshake)
+    bool keep_alive{true};
+
+    // Chamado na thread do servidor antes do loop (ex: desligar contadores)
+    std::function<void()> on_thread_start;
+};
+
+class LoopbackServer {
+public:
+    explicit LoopbackServer(LoopbackOptions options = {});
+    ~LoopbackServer();
+
+    LoopbackServer(const LoopbackServer&) = delete;
+    LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+    std::uint16_t port() const { return bound_port; }
+
+    // "http://127.0.0.1:<porta><path>"
+    std::string url(std::string_view path) const;
+
+    std::uint64_t requests_served() const { return served.load(std::memory_order_relaxed); }
+
+    // Conexões TCP aceitas desde o início (mede o reaproveitamento do keep-alive)
+    std::uint64_t connections_accepted() const { return accepted.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    LoopbackOptions options;
+    int listen_fd{-1};
+    int wake_pipe[2]{-1, -1};
+    std::uint16_t bound_port{0};
+    std::atomic<std::uint64_t> served{0};
+    std::atomic<std::uint64_t> accepted{0};
+    std::thread thread;
+};
+
+// Documento de /json com N objetos; o formato lembra uma listagem paginada de API
+std::string make_json(std::uint64_t items);
+
+} // namespace locosync::bench
+
+#endif // LOCOSYNC_BENCH_LOOPBACK_SERVER_HPP
@@ -2,6 +2,51 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <optional>
+#include <vector>
+
+// Formato da listagem da PokéAPI, decodificado direto dos bytes com as<T>()
+struct PokemonRef {
+    std::string name;
+    std::string url;
+};
+LOCOSYNC_FIELDS(PokemonRef, name, url)
+
+struct PokemonPage {
+    int count{0};
+    std::optional<std::string> next; // null na última página
+    std::vector<PokemonRef> results;
+};
+LOCOSYNC_FIELDS(PokemonPage, count, next, results)
+
+struct PokemonDetail {
+    std::string name;
+    int weight{0};
+};
+LOCOSYNC_FIELDS(PokemonDetail, name, weight)
+
+// Versão com corrotinas: segue os links "next" da paginação sem bloquear threads
+locosync::Task<int> list_pages(locosync::Client& client, std::string url, int max_pages) {
+    int listed = 0;
+    for (int page = 1; page <= max_pages && !url.empty(); ++page) {
+        locosync::Response res = co_await client.co_get(url);
+        if (!res.ok()) {
+            std::cerr << "Erro na página " << page << ": " << res.error_message << std::endl;
+            break;
+        }
+
+        auto data = res.try_as<PokemonPage>();
+        if (!data) break;
+        std::cout << "Página " << page << ":" << std::endl;
+        for (const auto& pokemon : data->results) {
+            std::cout << " - " << pokemon.name << std::endl;
+            ++listed;
+        }
+
+        url = data->next.value_or("");
+    }
+    co_return listed;
+}
 
 int main() {
     std::cout << "🚀 LocoSync Pokémon List Example" << std::endl;
@@ -24,11 +69,11 @@ int main() {
     locosync::Response res = future_res.get();
 
     if (res.ok()) {
-        auto data = res.json();
+        // DOM (nlohmann::json): parseado uma vez e reaproveitado nas chamadas seguintes
+        const auto& data = res.json_ref();
         std::cout << "Total de Pokémons disponíveis: " << data.value("count", 0) << std::endl;
-        auto results = data["results"];
         std::cout << "Primeiros 20 Pokémons:" << std::endl;
-        for (const auto& pokemon : results) {
+        for (const auto& pokemon : data.value("results", nlohmann::json::array())) {
             std::string name = pokemon.value("name", "N/A");
             std::string url = pokemon.value("url", "N/A");
             std::cout << " - " << name << " (" << url << ")" << std::endl;
@@ -38,6 +83,42 @@ int main() {
         std::cerr << "Erro ao buscar Pokémons: " << res.error_message << std::endl;
     }
 
+    std::cout << "--------------------------------" << std::endl;
+    std::cout << "Paginação com co_await (Engine::Reactor)" << std::endl;
+
+    locosync::ClientOptions options;
+    options.engine = locosync::Engine::Reactor;
+    auto reactor_client = locosync::Client::create(options);
+
+    // As corrotinas são retomadas nesta thread; o I/O roda na thread do reactor
+    locosync::Executor executor;
+    int listed = executor.run(list_pages(*reactor_client, url, 3));
+    std::cout << "Pokémons listados via corrotina: " << listed << std::endl;
+
+    std::cout << "--------------------------------" << std::endl;
+    std::cout << "Detalhes em lote (fan-out multiplexado)" << std::endl;
+
+    auto page = res.ok() ? res.try_as<PokemonPage>() : std::nullopt;
+    if (page) {
+        std::vector<locosync::Request> details;
+        for (const auto& pokemon : page->results) {
+            locosync::Request r;
+            r.url = pokemon.url;
+            details.push_back(std::move(r));
+        }
+
+        locosync::BatchOptions batch_options;
+        batch_options.max_concurrency = 8;
+        auto responses = reactor_client->batch(std::move(details), batch_options).get();
+        for (const auto& detail : responses) {
+            if (!detail.ok()) continue;
+            // Só name e weight são decodificados; o resto do JSON é pulado
+            auto data = detail.try_as<PokemonDetail>();
+            if (!data) continue;
+            std::cout << " - " << data->name << ": " << data->weight << " hg" << std::endl;
+        }
+    }
+
     std::cout << "--------------------------------" << std::endl;
     std::cout << "Fim do exemplo." << std::endl;
     return 0;
@@ -0,0 +1,55 @@
+#ifndef LOCOSYNC_BATCH_HPP
+#define LOCOSYNC_BATCH_HPP
+
+#include "response.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace locosync {
+
+class Client;
+
+// Opções de Client::batch() / Client::batch_stream()
+struct BatchOptions {
+    // Máximo de requisições do lote em voo ao mesmo tempo
+    std::size_t max_concurrency{16};
+
+    // HTTP/2: novas transferências esperam (PIPEWAIT) para multiplexar numa
+    // conexão já aberta com o host em vez de abrir uma conexão cada
+    bool multiplex{true};
+};
+
+// Resultado de um lote, com a posição da requisição no vetor original
+struct BatchResult {
+    std::size_t index{0};
+    Response response;
+};
+
+// Fluxo de resultados na ordem em que as transferências terminam
+class BatchStream {
+public:
+    explicit BatchStream(std::size_t total) : total(total) {}
+
+    // Bloqueia até o próximo resultado; std::nullopt quando todos já foram entregues
+    std::optional<BatchResult> next();
+
+    std::size_t size() const { return total; }
+
+private:
+    friend class Client;
+    void push(std::size_t index, Response response);
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<BatchResult> results;
+    std::size_t total;
+    std::size_t delivered{0};
+};
+
+} // namespace locosync
+
+#endif // LOCOSYNC_BATCH_HPP
@@ -0,0 +1,57 @@
+#ifndef LOCOSYNC_BODY_HPP
+#define LOCOSYNC_BODY_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace locosync {
+
+// Corpo de requisição. Pode ser dono dos bytes (std::string), apenas
+// referenciar memória do chamador (borrow) ou mapear um arquivo (map_file).
+// Em todos os casos o envio é feito direto desta memória, sem cópias extras.
+class Body {
+public:
+    Body() = default;
+
+    // Construtores explícitos: evitam ambiguidade com nlohmann::json em post()/put()
+    explicit Body(std::string data) : owned(std::move(data)) {}
+    explicit Body(const char* data) : owned(data ? data : "") {}
+
+    Body& operator=(std::string data) {
+        owned = std::move(data);
+        external = {};
+        mapping.reset();
+        is_external = false;
+        return *this;
+    }
+
+    Body& operator=(const char* data) { return *this = std::string(data ? data : ""); }
+
+    // Referencia memória do chamador, que precisa viver até a resposta chegar
+    static Body borrow(std::string_view data);
+
+    // Mapeia um arquivo em memória (somente leitura). Lança std::system_error
+    // se o arquivo não puder ser aberto ou mapeado.
+    static Body map_file(const std::string& path);
+
+    // Passa um corpo próprio para memória compartilhada: a partir daí cópias
+    // do Body (e da Request) não copiam os bytes
+    void share();
+
+    std::string_view view() const { return is_external ? external : std::string_view(owned); }
+    const char* data() const { return view().data(); }
+    std::size_t size() const { return view().size(); }
+    bool empty() const { return size() == 0; }
+
+private:
+    std::string owned;
+    std::string_view external;             // borrow() ou arquivo mapeado
+    std::shared_ptr<const void> mapping;   // mantém o mapeamento (ou share()) vivo entre cópias
+    bool is_external{false};
+};
+
+} // namespace locosync
+
+#endif // LOCOSYNC_BODY_HPP
@@ -1,22 +1,50 @@
 #ifndef LOCOSYNC_CLIENT_HPP
 #define LOCOSYNC_CLIENT_HPP
 
+#include "batch.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "interceptor.hpp"
+#include "options.hpp"
+#include "task.hpp"
 
+#include <atomic>
 #include <string>
 #include <future>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <nlohmann/json.hpp>
 
 namespace locosync {
 
+namespace detail {
+struct BatchRun;
+class Coalescer;
+class ConnectionPool;
+class HttpCache;
+class LatencyTracker;
+class MetricsRegistry;
+class RetryBudget;
+class TimerQueue;
+struct HedgeState;
+class Reactor;
+class TransferPool;
+struct Transfer;
+}
+
 class Client {
 public:
+    // Chamado na thread do engine quando a resposta fica pronta. O callback
+    // pode soltar a última referência ao Client: a destruição é adiada para
+    // outra thread e acontece depois que ele retornar.
+    using Callback = std::function<void(Response)>;
+
     // Factory
     static std::shared_ptr<Client> create();
+    static std::shared_ptr<Client> create(const ClientOptions& options);
 
     // Destrutor (declarado para permitir definição no .cpp)
     virtual ~Client();
@@ -24,20 +52,112 @@ public:
     // Método genérico
     std::future<Response> request(const Request& req);
 
+    // Variante que consome a Request: nenhum header ou corpo é copiado
+    std::future<Response> request(Request&& req);
+
+    // Variante com callback (sem std::future); base para as demais APIs
+    void request(Request req, Callback on_complete);
+
     // Conveniências
     std::future<Response> get(const std::string& url);
     std::future<Response> post(const std::string& url, const nlohmann::json& body);
     std::future<Response> put(const std::string& url, const nlohmann::json& body);
     std::future<Response> del(const std::string& url);
 
+    // Corpo já serializado, emprestado ou arquivo mapeado (ver body.hpp).
+    // Sem Content-Type explícito é enviado "application/json".
+    std::future<Response> post(const std::string& url, Body&& body);
+    std::future<Response> put(const std::string& url, Body&& body);
+
+    // GET em streaming: o corpo vai para o sink conforme chega
+    std::future<Response> get(const std::string& url, std::shared_ptr<BodySink> sink);
+
+    // Corrotinas (C++20): co_await suspende sem bloquear a thread. Dentro de
+    // Executor::run() a retomada acontece na thread do executor; fora dele,
+    // na thread do engine que concluiu a transferência.
+    Task<Response> co_request(Request req);
+    Task<Response> co_get(const std::string& url);
+    Task<Response> co_post(const std::string& url, const nlohmann::json& body);
+    Task<Response> co_put(const std::string& url, const nlohmann::json& body);
+    Task<Response> co_del(const std::string& url);
+
+    // Lote (fan-out): todas as requisições vão para o engine reativo de uma
+    // vez, até max_concurrency em voo, multiplexadas em HTTP/2 quando o
+    // servidor permite. Com Engine::Threaded um reactor é criado sob demanda.
+    // Resultados na mesma ordem de `requests`:
+    std::future<std::vector<Response>> batch(std::vector<Request> requests, const BatchOptions& batch_options = {});
+    // ...ou na ordem em que terminam:
+    std::shared_ptr<BatchStream> batch_stream(std::vector<Request> requests, const BatchOptions& batch_options = {});
+
     // Interceptors
     void add_interceptor(std::unique_ptr<Interceptor> interceptor);
 
+    // Contadores do pool de conexões (hits/misses)
+    PoolStats pool_stats() const;
+
+    // Contadores de hedging (ClientOptions::hedging)
+    HedgeStats hedge_stats() const;
+
+    // Contadores do cache HTTP (zerados se ClientOptions::cache estiver desligado)
+    CacheStats cache_stats() const;
+
+    // Métricas por host no formato texto do Prometheus (vazio se
+    // ClientOptions::collect_metrics estiver desligado)
+    std::string prometheus_metrics() const;
+
 protected:
-    Client();
+    explicit Client(const ClientOptions& options = {});
 
 private:
+    // Entrega a requisição ao engine configurado (sem coalescing/hedging)
+    void dispatch(Request req, Callback on_complete, std::shared_ptr<std::atomic<bool>> cancel = nullptr);
+    // Duas tentativas, a segunda após o atraso aprendido para o host
+    void dispatch_hedged(Request req, Callback on_complete, const std::string& origin);
+    void finish_attempt(const std::shared_ptr<detail::HedgeState>& state, int attempt, Response res);
+
+    // Engine::Threaded: executa a requisição inteira na thread atual
+    Response perform(Request req, std::shared_ptr<std::atomic<bool>> cancel = nullptr);
+    // Engine::Reactor (e lotes): prepara a Transfer e entrega ao reactor
+    void submit(detail::Reactor& engine, detail::ConnectionPool& handles, Request req, Callback on_complete,
+                bool multiplex = false, std::shared_ptr<std::atomic<bool>> cancel = nullptr);
+    void start_batch(std::vector<Request> requests, const BatchOptions& batch_options,
+                     std::function<void(std::size_t, Response)> deliver);
+    void pump_batch(const std::shared_ptr<detail::BatchRun>& run);
+    // Interceptors de saída; retorna o tempo gasto, em segundos
+    double run_request_interceptors(Request& req);
+    // Interceptors de entrada; o tempo gasto vai para res.timings.interceptors
+    void run_response_interceptors(Response& res);
+
+    ClientOptions options;
     std::vector<std::unique_ptr<Interceptor>> interceptors;
+    std::unique_ptr<detail::ConnectionPool> pool;
+    std::unique_ptr<detail::HttpCache> cache;
+    std::unique_ptr<detail::Coalescer> coalescer;
+    std::unique_ptr<detail::MetricsRegistry> metrics;
+
+    // Hedging e timeouts adaptativos (criados só se habilitados)
+    std::unique_ptr<detail::LatencyTracker> latencies;
+    std::unique_ptr<detail::RetryBudget> hedge_budget;
+    std::unique_ptr<detail::TimerQueue> timers;
+    std::atomic<std::uint64_t> hedged{0};
+    std::atomic<std::uint64_t> hedge_wins{0};
+    std::atomic<std::uint64_t> budget_denied{0};
+    // Arena de Transfers; declarada antes do reactor, que devolve Transfers a ela
+    std::unique_ptr<detail::TransferPool> transfers;
+    std::unique_ptr<detail::Reactor> reactor;
+
+    // Reactor e pool dos lotes quando o engine é Threaded (criados no primeiro batch)
+    std::once_flag batch_engine_once;
+    std::unique_ptr<detail::ConnectionPool> batch_pool;
+    std::unique_ptr<detail::Reactor> batch_reactor;
+
+    // Sinaliza aos lotes em andamento que não devem iniciar novas transferências
+    std::atomic<bool> closing{false};
+
+    // Threads em voo do Engine::Threaded; o destrutor aguarda todas terminarem
+    std::mutex threads_mutex;
+    std::condition_variable threads_idle;
+    std::size_t threads_inflight{0};
 };
 
 } // namespace locosync
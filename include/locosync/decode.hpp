@@ -0,0 +1,226 @@
+#ifndef LOCOSYNC_DECODE_HPP
+#define LOCOSYNC_DECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace locosync {
+
+// JSON inválido ou com tipo incompatível com o destino
+class DecodeError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+// Valor escalar recebido do parser SAX
+struct Scalar {
+    enum class Kind { Null, Bool, Int, Uint, Float, String };
+    Kind kind{Kind::Null};
+    bool boolean{false};
+    std::int64_t integer{0};
+    std::uint64_t unsigned_integer{0};
+    double floating{0.0};
+    std::string* string{nullptr}; // pode ser movida para o destino
+};
+
+struct TypeOps;
+
+// Onde o próximo valor do JSON será escrito; target nulo = valor ignorado
+struct Dest {
+    void* target{nullptr};
+    const TypeOps* ops{nullptr};
+};
+
+// Tabela de operações de um tipo de destino (uma instância estática por tipo)
+struct TypeOps {
+    const char* expected; // para mensagens de erro
+    bool (*scalar)(void* target, Scalar& value);
+    // Início de objeto/array: `frame` recebe o container que vai receber os filhos
+    bool (*open)(void* target, bool array, Dest& frame);
+    // Filho de um container: campo/chave de objeto ou próximo elemento (key vazia)
+    Dest (*child)(void* target, std::string_view key);
+};
+
+// Percorre o JSON com nlohmann::json::sax_parse escrevendo direto em `root`
+bool decode_json(std::string_view text, Dest root, std::string& error);
+
+template <typename T> struct is_optional : std::false_type {};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+template <typename T> struct is_vector : std::false_type {};
+template <typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+template <typename T> struct is_string_map : std::false_type {};
+template <typename V, typename C, typename A>
+struct is_string_map<std::map<std::string, V, C, A>> : std::true_type {};
+template <typename V, typename H, typename E, typename A>
+struct is_string_map<std::unordered_map<std::string, V, H, E, A>> : std::true_type {};
+
+struct FieldProbe {
+    template <typename F> void operator()(const char*, F&) const {}
+};
+
+// Tipos com LOCOSYNC_FIELDS (encontrado por ADL no namespace do tipo)
+template <typename T>
+concept Described = requires(T& value, FieldProbe probe) { locosync_fields(value, probe); };
+
+// std::in_range não aceita tipos de caractere (char, char8_t, wchar_t...):
+// o intervalo é verificado pelo inteiro de mesmo tamanho e sinal
+template <typename T>
+using range_type = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+
+template <typename T> bool scalar_into(void* target, Scalar& value);
+template <typename T> bool open_into(void* target, bool array, Dest& frame);
+template <typename T> Dest child_of(void* target, std::string_view key);
+template <typename T> constexpr const char* expected_name();
+
+template <typename T>
+inline constexpr TypeOps ops_for{expected_name<T>(), &scalar_into<T>, &open_into<T>, &child_of<T>};
+
+template <typename T> constexpr const char* expected_name() {
+    if constexpr (std::is_same_v<T, bool>) return "boolean";
+    else if constexpr (std::is_integral_v<T>) return "integer";
+    else if constexpr (std::is_floating_point_v<T>) return "number";
+    else if constexpr (std::is_same_v<T, std::string>) return "string";
+    else if constexpr (is_optional<T>::value) return expected_name<typename T::value_type>();
+    else if constexpr (is_vector<T>::value) return "array";
+    else return "object";
+}
+
+template <typename T> bool scalar_into(void* target, Scalar& value) {
+    using Kind = Scalar::Kind;
+    T& out = *static_cast<T*>(target);
+
+    // null: optional vazio; nos demais tipos o valor padrão é mantido
+    if (value.kind == Kind::Null) {
+        if constexpr (is_optional<T>::value) out.reset();
+        return true;
+    }
+
+    if constexpr (std::is_same_v<T, bool>) {
+        if (value.kind != Kind::Bool) return false;
+        out = value.boolean;
+        return true;
+    } else if constexpr (std::is_integral_v<T>) {
+        using R = range_type<T>;
+        if (value.kind == Kind::Int && std::in_range<R>(value.integer)) {
+            out = static_cast<T>(value.integer);
+            return true;
+        }
+        if (value.kind == Kind::Uint && std::in_range<R>(value.unsigned_integer)) {
+            out = static_cast<T>(value.unsigned_integer);
+            return true;
+        }
+        return false;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (value.kind == Kind::Float) out = static_cast<T>(value.floating);
+        else if (value.kind == Kind::Int) out = static_cast<T>(value.integer);
+        else if (value.kind == Kind::Uint) out = static_cast<T>(value.unsigned_integer);
+        else return false;
+        return true;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        if (value.kind != Kind::String) return false;
+        out = std::move(*value.string);
+        return true;
+    } else if constexpr (is_optional<T>::value) {
+        out.emplace();
+        return scalar_into<typename T::value_type>(&*out, value);
+    } else {
+        return false; // objeto/array esperado
+    }
+}
+
+template <typename T> bool open_into(void* target, bool array, Dest& frame) {
+    T& out = *static_cast<T*>(target);
+    if constexpr (is_optional<T>::value) {
+        out.emplace();
+        return open_into<typename T::value_type>(&*out, array, frame);
+    } else if constexpr (is_vector<T>::value) {
+        static_assert(!std::is_same_v<typename T::value_type, bool>, "std::vector<bool> has no element references; decode into std::vector<char> instead");
+        if (!array) return false;
+        out.clear();
+        frame = {target, &ops_for<T>};
+        return true;
+    } else if constexpr (is_string_map<T>::value || Described<T>) {
+        if (array) return false;
+        if constexpr (is_string_map<T>::value) out.clear();
+        frame = {target, &ops_for<T>};
+        return true;
+    } else {
+        return false; // escalar esperado
+    }
+}
+
+template <typename T> Dest child_of(void* target, [[maybe_unused]] std::string_view key) {
+    T& out = *static_cast<T*>(target);
+    if constexpr (is_vector<T>::value) {
+        using Element = typename T::value_type;
+        out.emplace_back();
+        return {&out.back(), &ops_for<Element>};
+    } else if constexpr (is_string_map<T>::value) {
+        using Mapped = typename T::mapped_type;
+        return {&out[std::string(key)], &ops_for<Mapped>};
+    } else if constexpr (Described<T>) {
+        Dest dest;
+        locosync_fields(out, [&](const char* name, auto& field) {
+            if (!dest.target && key == name) {
+                dest = {&field, &ops_for<std::remove_cvref_t<decltype(field)>>};
+            }
+        });
+        return dest;
+    } else {
+        return {};
+    }
+}
+
+} // namespace detail
+
+// Decodifica JSON direto no tipo T (sem montar nlohmann::json). Tipos aceitos:
+// bool, inteiros (inclusive char/char8_t...), ponto flutuante, std::string,
+// std::optional, std::vector, std::map/unordered_map com chave std::string e
+// structs com LOCOSYNC_FIELDS.
+// Chaves desconhecidas são ignoradas. Lança DecodeError.
+template <typename T> T decode_json(std::string_view text) {
+    T out{};
+    std::string error;
+    if (!detail::decode_json(text, {&out, &detail::ops_for<T>}, error)) throw DecodeError(error);
+    return out;
+}
+
+// Variante sem exceção de DecodeError: std::nullopt em erro
+template <typename T> std::optional<T> try_decode_json(std::string_view text) {
+    std::optional<T> out(std::in_place);
+    std::string error;
+    if (!detail::decode_json(text, {&*out, &detail::ops_for<T>}, error)) return std::nullopt;
+    return out;
+}
+
+} // namespace locosync
+
+#define LOCOSYNC_DETAIL_VISIT_FIELD(field) locosync_visitor(#field, locosync_self.field);
+
+// Declara os campos de uma struct para Response::as<T>() / decode_json<T>().
+// Usar no mesmo namespace da struct (o mapeamento é achado por ADL); o nome
+// de cada membro é a chave no JSON.
+//
+//   struct Pokemon { std::string name; std::string url; };
+//   LOCOSYNC_FIELDS(Pokemon, name, url)
+#define LOCOSYNC_FIELDS(Type, ...)                                                                   \
+    template <typename LocoSyncVisitor>                                                              \
+    inline void locosync_fields(Type& locosync_self, LocoSyncVisitor&& locosync_visitor) {          \
+        NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(LOCOSYNC_DETAIL_VISIT_FIELD, __VA_ARGS__))           \
+    }
+
+#endif // LOCOSYNC_DECODE_HPP
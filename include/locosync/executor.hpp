@@ -0,0 +1,92 @@
+#ifndef LOCOSYNC_EXECUTOR_HPP
+#define LOCOSYNC_EXECUTOR_HPP
+
+#include "task.hpp"
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+namespace locosync {
+
+// Executor de uma thread só: as corrotinas iniciadas por run() são sempre
+// retomadas na thread que chamou run(), mesmo quando a resposta chega em uma
+// thread do engine. Com Engine::Reactor, centenas de chamadas concorrentes
+// (ex: when_all) rodam a partir de uma única thread.
+class Executor {
+public:
+    Executor() = default;
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    // Enfileira a retomada de uma corrotina; pode ser chamado de qualquer thread
+    void post(std::coroutine_handle<> h);
+
+    // Executor ativo na thread atual (nullptr fora de run())
+    static Executor* current() noexcept;
+
+    // Executa a tarefa nesta thread até o fim e devolve o resultado
+    template <typename T>
+    T run(Task<T> task);
+
+private:
+    // Processa retomadas enfileiradas até done ficar verdadeiro
+    void drive(const bool& done);
+    static Executor* exchange_current(Executor* executor) noexcept;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::coroutine_handle<>> queue;
+};
+
+namespace detail {
+
+template <typename T>
+struct RootResult {
+    std::optional<T> value;
+    std::exception_ptr error;
+    bool done{false};
+};
+
+template <>
+struct RootResult<void> {
+    std::exception_ptr error;
+    bool done{false};
+};
+
+template <typename T>
+DetachedTask run_root(Task<T> task, RootResult<T>& out) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+        } else {
+            out.value.emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        out.error = std::current_exception();
+    }
+    out.done = true;
+}
+
+} // namespace detail
+
+template <typename T>
+T Executor::run(Task<T> task) {
+    detail::RootResult<T> out;
+
+    Executor* previous = exchange_current(this);
+    detail::run_root(std::move(task), out);
+    drive(out.done);
+    exchange_current(previous);
+
+    if (out.error) std::rethrow_exception(out.error);
+    if constexpr (!std::is_void_v<T>) return std::move(*out.value);
+}
+
+} // namespace locosync
+
+#endif // LOCOSYNC_EXECUTOR_HPP
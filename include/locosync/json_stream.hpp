@@ -0,0 +1,82 @@
+#ifndef LOCOSYNC_JSON_STREAM_HPP
+#define LOCOSYNC_JSON_STREAM_HPP
+
+#include "sink.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace locosync {
+
+// Parser JSON incremental (push): aceita pedaços de tamanho arbitrário, na
+// ordem em que chegam da rede, e emite os eventos do nlohmann::json_sax sem
+// montar o DOM. Tokens que atravessam pedaços são acumulados internamente.
+class JsonPushParser {
+public:
+    using Sax = nlohmann::json_sax<nlohmann::json>;
+
+    explicit JsonPushParser(Sax& handler);
+
+    // Retorna false em erro de sintaxe ou quando o handler pede para parar
+    bool feed(const char* data, std::size_t size);
+
+    // Sinaliza o fim da entrada; falha se o documento estiver incompleto
+    bool finish();
+
+    bool failed() const { return !error_message.empty(); }
+    const std::string& error() const { return error_message; }
+
+private:
+    enum class Expect { Value, FirstValueOrEnd, FirstKeyOrEnd, Key, Colon, CommaOrEnd, Done };
+    enum class Token { None, String, Number, Literal };
+
+    bool structural(char c);
+    bool string_char(const char* data, std::size_t size, std::size_t& i);
+    bool utf8_byte(unsigned char b);
+    bool after_value();
+    bool end_string();
+    bool end_number();
+    bool end_literal();
+    bool append_code_point(std::uint32_t cp);
+    bool fail(const std::string& message);
+    bool check(bool handler_result);
+
+    Sax& sax;
+    std::vector<char> stack; // '{' ou '['
+    Expect expect{Expect::Value};
+    Token token{Token::None};
+    bool string_is_key{false};
+    std::string buffer;
+
+    // Estado de escape dentro de strings: 0 nenhum, 1 após '\', 2..5 dígitos de \uXXXX
+    int escape{0};
+    std::uint32_t hex{0};
+    std::uint32_t high_surrogate{0};
+
+    // Sequência UTF-8 em andamento: bytes de continuação restantes e a faixa
+    // aceita para o próximo
+    int utf8_left{0};
+    unsigned char utf8_low{0x80};
+    unsigned char utf8_high{0xBF};
+
+    std::size_t position{0};
+    std::string error_message;
+};
+
+// Sink que alimenta um handler SAX do nlohmann diretamente com os pedaços recebidos
+std::shared_ptr<BodySink> json_sax_sink(nlohmann::json_sax<nlohmann::json>& handler);
+
+// Sink que entrega, um a um, os elementos do array apontado por `pointer`
+// (JSON Pointer com chaves de objeto, ex: "/results"; "" = array raiz).
+// Só o elemento corrente fica em memória. Retornar false no callback aborta.
+std::shared_ptr<BodySink> json_array_sink(std::string pointer,
+                                          std::function<bool(nlohmann::json&&)> on_element);
+
+} // namespace locosync
+
+#endif // LOCOSYNC_JSON_STREAM_HPP
@@ -5,9 +5,17 @@
 inline constexpr char LOCOSYNC_VERSION[] = "0.1.0";
 
 // Includes públicos
+#include "body.hpp"
+#include "sink.hpp"
+#include "json_stream.hpp"
+#include "decode.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "interceptor.hpp"
+#include "options.hpp"
+#include "task.hpp"
+#include "executor.hpp"
+#include "batch.hpp"
 #include "client.hpp"
 
 #endif // LOCOSYNC_LOCOSYNC_HPP
\ No newline at end of file
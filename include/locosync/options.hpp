@@ -0,0 +1,171 @@
+#ifndef LOCOSYNC_OPTIONS_HPP
+#define LOCOSYNC_OPTIONS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace locosync {
+
+// Configuração do pool de conexões persistentes (Keep-Alive)
+struct PoolOptions {
+    // Tempo máximo que um handle/conexão pode ficar ocioso antes de ser descartado
+    std::chrono::milliseconds idle_timeout{std::chrono::seconds(60)};
+
+    // Limite de transferências simultâneas por host (0 = sem limite)
+    std::size_t max_connections_per_host{0};
+
+    // Quantidade de handles ociosos mantidos por host para reutilização
+    std::size_t max_idle_per_host{8};
+
+    // Caches compartilhados entre todos os handles do Client.
+    // Conexões ficam no próprio easy handle, reaproveitado pelo pool por origem.
+    // share_connections põe CURL_LOCK_DATA_CONNECT no CURLSH, que a libcurl não
+    // suporta com handles em threads simultâneas: só ligue se o Client não faz
+    // requisições concorrentes. Com Engine::Reactor o cache de conexões fica em
+    // cada multi handle (share_connections é ignorado).
+    bool share_dns{true};
+    bool share_tls_sessions{true};
+    bool share_connections{false};
+};
+
+// Contadores do pool (snapshot)
+struct PoolStats {
+    std::uint64_t hits{0};      // handle reaproveitado
+    std::uint64_t misses{0};    // handle novo criado
+    std::uint64_t evictions{0}; // handles descartados por ociosidade ou excesso
+    std::size_t idle{0};
+    std::size_t in_use{0};
+};
+
+// Cache HTTP de respostas GET (opt-in). Segue Cache-Control/Expires e
+// revalida com If-None-Match / If-Modified-Since; um 304 serve a cópia local.
+struct CacheOptions {
+    bool enabled{false};
+
+    // Orçamento de memória (corpo + headers) dividido entre os shards do LRU
+    std::size_t max_bytes{64 * 1024 * 1024};
+    std::size_t shards{16};
+
+    // Camada em disco opcional (arquivo append-only mapeado em memória).
+    // Vazio = somente memória. Permite reiniciar o processo com o cache quente.
+    std::string disk_path;
+    std::size_t max_disk_bytes{256 * 1024 * 1024};
+};
+
+// Contadores do cache (snapshot)
+struct CacheStats {
+    std::uint64_t hits{0};          // servido do cache sem ir à rede
+    std::uint64_t misses{0};        // sem entrada utilizável: resposta completa da rede
+    std::uint64_t revalidations{0}; // 304 Not Modified: corpo servido do cache
+    std::uint64_t disk_hits{0};     // entradas recuperadas da camada em disco
+    std::uint64_t stores{0};
+    std::uint64_t evictions{0};
+    std::size_t bytes{0};           // ocupação atual em memória
+    std::size_t entries{0};
+};
+
+// Hedging: se um GET/PUT/DELETE não responde dentro do percentil de latência
+// observado para o host, uma segunda tentativa é enviada; vence a primeira
+// resposta e a outra é cancelada.
+struct HedgingOptions {
+    bool enabled{false};
+
+    // Atraso do hedge = este percentil das latências recentes do host
+    double percentile{0.95};
+    std::size_t min_samples{20}; // antes disso não há hedge para o host
+    std::chrono::milliseconds min_delay{5};
+    std::chrono::milliseconds max_delay{std::chrono::seconds(2)};
+
+    // Orçamento (token bucket): cada requisição rende budget_ratio fichas,
+    // cada hedge gasta uma. Sob sobrecarga o tráfego extra fica limitado a ~10%.
+    double budget_ratio{0.1};
+    double budget_burst{10.0};
+};
+
+// Timeouts adaptativos: o timeout total passa a ser percentil * multiplier
+// da latência do host, sem nunca passar de Request::timeout_ms. Cada timeout
+// estourado conta como amostra do tamanho do timeout, então um host que ficou
+// mais lento volta a ter timeouts maiores depois de algumas falhas.
+struct AdaptiveTimeoutOptions {
+    bool enabled{false};
+    double percentile{0.999};
+    double multiplier{3.0};
+    std::size_t min_samples{100};
+    std::chrono::milliseconds min_timeout{100};
+};
+
+// Contadores de hedging (snapshot)
+struct HedgeStats {
+    std::uint64_t hedged{0};        // segundas tentativas enviadas
+    std::uint64_t hedge_wins{0};    // a segunda tentativa respondeu primeiro
+    std::uint64_t budget_denied{0}; // hedge não enviado por falta de orçamento
+};
+
+// Codificação do corpo enviado (header Content-Encoding)
+enum class ContentEncoding {
+    Identity, // sem compressão
+    Gzip,     // zlib
+    Brotli,   // libbrotlienc
+    Zstd      // libzstd
+};
+
+// Compressão nos dois sentidos
+struct CompressionOptions {
+    // Envia Accept-Encoding com tudo que o cURL sabe decodificar (gzip,
+    // deflate e, conforme o build, br e zstd). A resposta é descompactada em
+    // streaming direto em Response::body ou no sink.
+    bool accept_encoding{true};
+
+    // Compressão do corpo das requisições (opt-in). Corpos menores que
+    // request_min_bytes, ou que não diminuem, seguem sem compressão; também
+    // quando a biblioteca do algoritmo não estava disponível no build. Roda
+    // depois dos interceptors: um Content-Encoding posto por eles é respeitado.
+    ContentEncoding request_encoding{ContentEncoding::Identity};
+    std::size_t request_min_bytes{1024};
+    int level{-1}; // -1 = nível padrão do algoritmo
+};
+
+// Motor de execução das requisições
+enum class Engine {
+    Threaded, // uma thread por requisição bloqueada em curl_easy_perform
+    Reactor   // poucas threads dirigindo curl_multi_socket_action via epoll
+};
+
+// Como os headers da resposta são armazenados
+enum class ResponseLayout {
+    Map, // Response::headers (um nó e duas strings por header)
+    Flat // Response::raw_headers + header_index (um buffer, sem alocação por header)
+};
+
+// Opções passadas para Client::create()
+struct ClientOptions {
+    PoolOptions pool;
+
+    Engine engine{Engine::Threaded};
+
+    // Número de threads do reactor (apenas Engine::Reactor)
+    std::size_t reactor_threads{1};
+
+    ResponseLayout response_layout{ResponseLayout::Map};
+
+    CacheOptions cache;
+
+    // Singleflight: GETs idênticos (URL + headers) disparados enquanto um
+    // deles está em voo recebem o mesmo resultado de uma única transferência
+    bool coalesce_requests{false};
+
+    HedgingOptions hedging;
+    AdaptiveTimeoutOptions adaptive_timeouts;
+
+    // Contadores e histogramas por host (Client::prometheus_metrics()).
+    // Os timings por fase em Response::timings são preenchidos sempre.
+    bool collect_metrics{true};
+
+    CompressionOptions compression;
+};
+
+} // namespace locosync
+
+#endif // LOCOSYNC_OPTIONS_HPP
@@ -1,8 +1,12 @@
 #ifndef LOCOSYNC_REQUEST_HPP
 #define LOCOSYNC_REQUEST_HPP
 
+#include "body.hpp"
+#include "sink.hpp"
+
 #include <string>
 #include <map>
+#include <memory>
 
 namespace locosync {
 
@@ -19,7 +23,9 @@ struct Request {
     std::string url;
     Method method{Method::GET};
     std::map<std::string, std::string> headers;
-    std::string body;
+    // Corpo: std::string, memória emprestada (Body::borrow) ou arquivo mapeado
+    // (Body::map_file). Enviado em streaming, sem cópia para o cURL.
+    Body body;
 
     // Timeouts em milissegundos
     long timeout_ms{10000};
@@ -28,6 +34,10 @@ struct Request {
     bool follow_redirects{true};
     int max_redirects{5};
 
+    // Streaming: quando definido, o corpo da resposta vai para o sink pedaço a
+    // pedaço e Response::body fica vazio (ver sink.hpp / json_stream.hpp)
+    std::shared_ptr<BodySink> sink;
+
     std::string method_string() const {
         switch (method) {
             case Method::POST:    return "POST";
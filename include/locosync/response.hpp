@@ -1,39 +1,222 @@
 #ifndef LOCOSYNC_RESPONSE_HPP
 #define LOCOSYNC_RESPONSE_HPP
 
+#include "decode.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace locosync {
 
+// Comparação ASCII sem diferenciar maiúsculas (nomes de header são case-insensitive)
+inline bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+struct CaseInsensitiveLess {
+    using is_transparent = void;
+
+    bool operator()(std::string_view a, std::string_view b) const {
+        const std::size_t n = std::min(a.size(), b.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            char x = a[i], y = b[i];
+            if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+            if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+            if (x != y) return static_cast<unsigned char>(x) < static_cast<unsigned char>(y);
+        }
+        return a.size() < b.size();
+    }
+};
+
+using HeaderMap = std::map<std::string, std::string, CaseInsensitiveLess>;
+
+// Posição de um header dentro de Response::raw_headers (layout Flat).
+// Offsets em vez de string_view: a Response continua segura para copiar/mover.
+struct HeaderSpan {
+    std::uint32_t name_offset{0};
+    std::uint32_t name_size{0};
+    std::uint32_t value_offset{0};
+    std::uint32_t value_size{0};
+};
+
+// Tempo gasto em cada fase da requisição, em segundos (timers do cURL).
+// Fases de conexão ficam zeradas quando uma conexão do pool é reaproveitada.
+struct Timings {
+    double queue{0.0};        // espera até o cURL começar (fila do engine, limite do pool)
+    double dns{0.0};
+    double connect{0.0};      // handshake TCP
+    double tls{0.0};          // handshake TLS
+    double ttfb{0.0};         // requisição enviada -> primeiro byte da resposta
+    double transfer{0.0};     // primeiro -> último byte
+    double total{0.0};        // tempo do cURL (igual a elapsed_time)
+    double interceptors{0.0}; // on_request + on_response
+};
+
+namespace detail {
+
+// Resultado de Response::json()/json_ref(), calculado na primeira chamada e compartilhado
+// pelas cópias da Response. A chave é o conteúdo do body (tamanho + hash
+// tirado no parse): reatribuição ou edição do body faz o próximo json()
+// parsear de novo. Conferir o hash custa uma passada no body, bem menos que
+// o parse.
+class JsonCache {
+public:
+    JsonCache() = default;
+    JsonCache(const JsonCache& other) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        entry = other.entry;
+        size = other.size;
+        hash = other.hash;
+    }
+    // Sem lock: mover uma Response em uso por outra thread já é corrida.
+    // noexcept para std::vector<Response> mover (e não copiar) ao crescer.
+    JsonCache(JsonCache&& other) noexcept
+        : entry(std::move(other.entry)), size(other.size), hash(other.hash) {}
+    JsonCache& operator=(JsonCache&& other) noexcept {
+        entry = std::move(other.entry);
+        size = other.size;
+        hash = other.hash;
+        return *this;
+    }
+    JsonCache& operator=(const JsonCache& other) {
+        if (this == &other) return *this;
+        std::scoped_lock lock(mutex, other.mutex);
+        entry = other.entry;
+        size = other.size;
+        hash = other.hash;
+        return *this;
+    }
+
+    // Seguro entre threads; chamadas simultâneas esperam um único parse
+    const nlohmann::json& get(const std::string& body) const {
+        const std::size_t current = std::hash<std::string_view>{}(body);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entry && size == body.size() && hash == current) return *entry;
+
+        auto fresh = std::make_shared<nlohmann::json>();
+        try {
+            if (body.empty()) *fresh = nlohmann::json::object();
+            else *fresh = nlohmann::json::parse(body);
+        } catch (const nlohmann::json::parse_error& e) {
+            *fresh = nlohmann::json({{"error", "invalid_json"}, {"details", e.what()}});
+        }
+        entry = std::move(fresh);
+        size = body.size();
+        hash = current;
+        return *entry;
+    }
+
+private:
+    mutable std::mutex mutex;
+    mutable std::shared_ptr<const nlohmann::json> entry;
+    mutable std::size_t size{0};
+    mutable std::size_t hash{0};
+};
+
+} // namespace detail
+
 struct Response {
     int status_code{0};
     std::string body;
-    std::map<std::string, std::string> headers;
+    HeaderMap headers;
     double elapsed_time{0.0};
     std::string error_message;
 
+    Timings timings;
+
+    // Corpo como veio pela rede (comprimido, se houve Content-Encoding) e
+    // depois de descompactado. Numa resposta servida do cache wire_bytes é 0.
+    std::uint64_t wire_bytes{0};
+    std::uint64_t decoded_bytes{0};
+
+    // Layout Flat (ClientOptions::response_layout): os headers ficam num único
+    // buffer e `headers` permanece vazio. Use header()/header_at() para ler.
+    std::string raw_headers;
+    std::vector<HeaderSpan> header_index;
+
+    detail::JsonCache json_cache;
+
     bool ok() const {
         return status_code >= 200 && status_code < 300 && error_message.empty();
     }
 
+    // DOM do corpo, por valor como sempre foi (res.json()["x"] continua
+    // valendo). O parse acontece uma única vez; cada chamada copia o DOM.
     nlohmann::json json() const {
-        try {
-            if (body.empty()) return nlohmann::json::object();
-            return nlohmann::json::parse(body);
-        } catch (const nlohmann::json::parse_error& e) {
-            return nlohmann::json({{"error", "invalid_json"}, {"details", e.what()}});
+        return json_cache.get(body);
+    }
+
+    // Mesmo DOM sem cópia. Válido enquanto a Response (ou uma cópia dela)
+    // existir e o body não for alterado. Só leitura: operator[] const com
+    // chave ausente é comportamento indefinido no nlohmann, use value()/at().
+    const nlohmann::json& json_ref() const {
+        return json_cache.get(body);
+    }
+
+    // Decodifica o corpo direto em T, sem DOM (ver decode.hpp / LOCOSYNC_FIELDS).
+    // Lança DecodeError se o JSON for inválido ou não casar com T.
+    template <typename T> T as() const {
+        return decode_json<T>(body);
+    }
+
+    template <typename T> std::optional<T> try_as() const {
+        return try_decode_json<T>(body);
+    }
+
+    // --- HEADERS (funcionam nos dois layouts) ---
+
+    std::size_t header_count() const {
+        return header_index.empty() ? headers.size() : header_index.size();
+    }
+
+    // i-ésimo header na ordem recebida (Flat) ou alfabética (Map)
+    std::pair<std::string_view, std::string_view> header_at(std::size_t i) const {
+        if (!header_index.empty()) {
+            const HeaderSpan& h = header_index[i];
+            const std::string_view raw(raw_headers);
+            return {raw.substr(h.name_offset, h.name_size), raw.substr(h.value_offset, h.value_size)};
         }
+        auto it = std::next(headers.begin(), static_cast<std::ptrdiff_t>(i));
+        return {it->first, it->second};
     }
 
-    std::string get_header(const std::string& name) const {
+    // Valor do header (sem diferenciar maiúsculas) sem cópia; vazio se ausente.
+    // Com headers repetidos no layout Flat vale o último, como no Map.
+    std::string_view header(std::string_view name) const {
+        for (std::size_t i = header_index.size(); i > 0; --i) {
+            const HeaderSpan& h = header_index[i - 1];
+            if (iequals(std::string_view(raw_headers).substr(h.name_offset, h.name_size), name)) {
+                return std::string_view(raw_headers).substr(h.value_offset, h.value_size);
+            }
+        }
         auto it = headers.find(name);
         if (it != headers.end()) return it->second;
         return {};
     }
+
+    std::string get_header(const std::string& name) const {
+        return std::string(header(name));
+    }
 };
 
 } // namespace locosync
 
-#endif // LOCOSYNC_RESPONSE_HPP
\ No newline at end of file
+#endif // LOCOSYNC_RESPONSE_HPP
@@ -0,0 +1,41 @@
+#ifndef LOCOSYNC_SINK_HPP
+#define LOCOSYNC_SINK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace locosync {
+
+// Destino incremental do corpo da resposta. Quando Request::sink está
+// definido, cada pedaço recebido é entregue aqui assim que chega e
+// Response::body permanece vazio (memória constante).
+class BodySink {
+public:
+    virtual ~BodySink() = default;
+
+    // Recebe um pedaço do corpo; retornar false aborta a transferência
+    virtual bool write(const char* data, std::size_t size) = 0;
+
+    // Chamado uma vez ao fim da transferência (ok = sem erro de transporte)
+    virtual void finish(bool ok) { (void)ok; }
+
+    // Mensagem de erro própria do sink (ex: JSON inválido); vazia se não houver
+    virtual std::string error() const { return {}; }
+};
+
+// Entrega cada pedaço para uma função; retornar false aborta
+std::shared_ptr<BodySink> callback_sink(std::function<bool(std::string_view)> on_chunk);
+
+// Escreve em um descritor de arquivo já aberto (não é fechado pelo sink)
+std::shared_ptr<BodySink> fd_sink(int fd);
+
+// Escreve em um std::ostream que precisa viver até o fim da transferência
+std::shared_ptr<BodySink> ostream_sink(std::ostream& out);
+
+} // namespace locosync
+
+#endif // LOCOSYNC_SINK_HPP
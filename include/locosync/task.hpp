@@ -0,0 +1,202 @@
+#ifndef LOCOSYNC_TASK_HPP
+#define LOCOSYNC_TASK_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace locosync {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    // Quem fez co_await nesta tarefa; retomado por transferência simétrica
+    std::coroutine_handle<> continuation{std::noop_coroutine()};
+    std::exception_ptr error;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            return h.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    void return_value(T v) { value.emplace(std::move(v)); }
+
+    T result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// Corrotina "fire and forget": começa imediatamente e se destrói ao terminar
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+// Tarefa preguiçosa: só começa a executar quando alguém faz co_await nela
+// (ou quando é entregue a Executor::run). Move-only.
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(handle_type h) noexcept : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool valid() const noexcept { return static_cast<bool>(handle); }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            handle_type handle;
+            bool await_ready() const noexcept { return handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{handle};
+    }
+
+private:
+    handle_type handle;
+};
+
+namespace detail {
+
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+template <typename T>
+struct WhenAllState {
+    using Slot = std::conditional_t<std::is_void_v<T>, unsigned char, std::optional<T>>;
+
+    explicit WhenAllState(std::size_t n) : remaining(n + 1), results(n) {}
+
+    std::atomic<std::size_t> remaining;
+    std::coroutine_handle<> waiter;
+    std::vector<Slot> results;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+
+    void arrive() {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) waiter.resume();
+    }
+};
+
+template <typename T>
+DetachedTask when_all_child(Task<T> task, WhenAllState<T>& state, std::size_t index) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            state.results[index] = 1;
+        } else {
+            state.results[index].emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        if (!state.failed.exchange(true)) state.error = std::current_exception();
+    }
+    state.arrive();
+}
+
+template <typename T>
+struct WhenAllAwaiter {
+    std::vector<Task<T>>& tasks;
+    WhenAllState<T>& state;
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        state.waiter = awaiting;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            when_all_child(std::move(tasks[i]), state, i);
+        }
+        // A unidade extra do contador impede retomar antes de todos começarem
+        return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+    void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+// Executa todas as tarefas concorrentemente e conclui quando a última terminar.
+// Os resultados mantêm a ordem de entrada; a primeira exceção é propagada.
+template <typename T>
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+    detail::WhenAllState<T> state(tasks.size());
+    co_await detail::WhenAllAwaiter<T>{tasks, state};
+    if (state.error) std::rethrow_exception(state.error);
+
+    std::vector<T> out;
+    out.reserve(state.results.size());
+    for (auto& slot : state.results) out.push_back(std::move(*slot));
+    co_return out;
+}
+
+inline Task<void> when_all(std::vector<Task<void>> tasks) {
+    detail::WhenAllState<void> state(tasks.size());
+    co_await detail::WhenAllAwaiter<void>{tasks, state};
+    if (state.error) std::rethrow_exception(state.error);
+}
+
+} // namespace locosync
+
+#endif // LOCOSYNC_TASK_HPP
@@ -0,0 +1,24 @@
+#include "locosync/batch.hpp"
+
+namespace locosync {
+
+std::optional<BatchResult> BatchStream::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [this] { return !results.empty() || delivered == total; });
+    if (results.empty()) return std::nullopt;
+
+    BatchResult result = std::move(results.front());
+    results.pop_front();
+    ++delivered;
+    return result;
+}
+
+void BatchStream::push(std::size_t index, Response response) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(BatchResult{index, std::move(response)});
+    }
+    ready.notify_one();
+}
+
+} // namespace locosync
@@ -0,0 +1,128 @@
+#include "locosync/body.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace locosync {
+
+namespace {
+
+// Região mapeada; desfeita quando a última cópia do Body é destruída
+struct MappedFile {
+    void* address{nullptr};
+    std::size_t length{0};
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (!address) return;
+#ifdef _WIN32
+        UnmapViewOfFile(address);
+#else
+        munmap(address, length);
+#endif
+    }
+};
+
+[[noreturn]] void throw_file_error(int code, const std::string& path) {
+    throw std::system_error(code, std::system_category(), "Could not map body file '" + path + "'");
+}
+
+} // namespace
+
+Body Body::borrow(std::string_view data) {
+    Body b;
+    b.external = data;
+    b.is_external = true;
+    return b;
+}
+
+void Body::share() {
+    if (is_external) return;
+    auto shared = std::make_shared<const std::string>(std::move(owned));
+    owned.clear();
+    external = *shared;
+    mapping = std::move(shared);
+    is_external = true;
+}
+
+Body Body::map_file(const std::string& path) {
+    auto mapped = std::make_shared<MappedFile>();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw_file_error(static_cast<int>(GetLastError()), path);
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        const int code = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        throw_file_error(code, path);
+    }
+
+    if (size.QuadPart > 0) {
+        HANDLE mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_handle) {
+            const int code = static_cast<int>(GetLastError());
+            CloseHandle(file);
+            throw_file_error(code, path);
+        }
+        mapped->address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        const int code = static_cast<int>(GetLastError());
+        // A view mantém o arquivo aberto; os handles podem ser fechados
+        CloseHandle(mapping_handle);
+        CloseHandle(file);
+        if (!mapped->address) throw_file_error(code, path);
+        mapped->length = static_cast<std::size_t>(size.QuadPart);
+    } else {
+        CloseHandle(file);
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw_file_error(errno, path);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        const int code = errno;
+        ::close(fd);
+        throw_file_error(code, path);
+    }
+
+    if (st.st_size > 0) {
+        void* address = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        const int code = errno;
+        // O mapeamento continua válido depois do close()
+        ::close(fd);
+        if (address == MAP_FAILED) throw_file_error(code, path);
+        mapped->address = address;
+        mapped->length = static_cast<std::size_t>(st.st_size);
+        // O upload lê o arquivo do início ao fim uma única vez
+        ::madvise(address, mapped->length, MADV_SEQUENTIAL);
+    } else {
+        ::close(fd);
+    }
+#endif
+
+    Body b;
+    b.external = std::string_view(static_cast<const char*>(mapped->address), mapped->length);
+    b.mapping = std::move(mapped);
+    b.is_external = true;
+    return b;
+}
+
+} // namespace locosync
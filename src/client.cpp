@@ -1,161 +1,647 @@
 #include "locosync/client.hpp"
+#include "locosync/executor.hpp"
+#include "coalescer.hpp"
+#include "compression.hpp"
+#include "connection_pool.hpp"
+#include "hedging.hpp"
+#include "http_cache.hpp"
+#include "metrics.hpp"
+#include "reactor.hpp"
+#include "transfer.hpp"
 #include <curl/curl.h>
-#include <mutex>
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
 
 namespace locosync {
 
+namespace detail {
+
+// Estado de um lote em andamento; compartilhado pelos callbacks das transferências
+struct BatchRun {
+    std::mutex mutex;
+    std::vector<Request> requests;
+    std::size_t next{0};
+    std::size_t in_flight{0};
+    std::size_t window{1};
+    bool multiplex{true};
+    bool pumping{false};
+    bool pump_again{false};
+    Reactor* engine{nullptr};
+    ConnectionPool* handles{nullptr};
+    std::function<void(std::size_t, Response)> deliver;
+};
+
+// Requisição com hedge: a primeira resposta válida vence, a outra é cancelada
+struct HedgeState {
+    std::mutex mutex;
+    Request backup;                 // cópia para a segunda tentativa (corpo compartilhado)
+    TimerQueue::Id timer;           // disparo do hedge, cancelado ao terminar
+    Client::Callback on_complete;
+    std::array<std::shared_ptr<std::atomic<bool>>, 2> cancel{
+        std::make_shared<std::atomic<bool>>(false), std::make_shared<std::atomic<bool>>(false)};
+    int outstanding{1};
+    bool done{false};
+};
+
+} // namespace detail
+
+namespace {
+
+// Métodos idempotentes, sem sink (dois writers no mesmo sink embaralhariam o corpo)
+bool hedgeable(const Request& req) {
+    return (req.method == Method::GET || req.method == Method::PUT || req.method == Method::DELETE_) && !req.sink;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
 // Inicialização única do cURL
 static std::once_flag curl_init_flag;
 
-// Callback para capturar o corpo da resposta
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-    size_t totalSize = size * nmemb;
-    auto* body = static_cast<std::string*>(userp);
-    try {
-        body->append(static_cast<char*>(contents), totalSize);
-        return totalSize;
-    } catch (...) { return 0; }
-}
-
-// Callback para capturar e parsear Headers de resposta
-static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
-    size_t totalSize = size * nitems;
-    std::string headerLine(buffer, totalSize);
-    auto* headers = static_cast<std::map<std::string, std::string>*>(userdata);
-
-    size_t colonPos = headerLine.find(':');
-    if (colonPos != std::string::npos) {
-        std::string key = headerLine.substr(0, colonPos);
-        std::string value = headerLine.substr(colonPos + 1);
-
-        // Trim básico para remover espaços e \r\n
-        auto trim = [](std::string& s) {
-            s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) { return !std::isspace(ch); }));
-            s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) { return !std::isspace(ch); }).base(), s.end());
-        };
-        trim(key); trim(value);
-        if (!key.empty()) (*headers)[key] = value;
-    }
-    return totalSize;
-}
+// Client cujo callback está rodando nesta thread (engine, reactor ou timer)
+static thread_local const Client* callback_owner = nullptr;
+
+namespace {
+
+struct CallbackScope {
+    explicit CallbackScope(const Client* client) : previous(std::exchange(callback_owner, client)) {}
+    ~CallbackScope() { callback_owner = previous; }
+    CallbackScope(const CallbackScope&) = delete;
+    CallbackScope& operator=(const CallbackScope&) = delete;
+    const Client* previous;
+};
+
+} // namespace
 
 std::shared_ptr<Client> Client::create() {
-    struct MakeSharedEnabler : public Client {};
-    return std::make_shared<MakeSharedEnabler>();
+    return create(ClientOptions{});
+}
+
+std::shared_ptr<Client> Client::create(const ClientOptions& options) {
+    struct MakeSharedEnabler : public Client {
+        explicit MakeSharedEnabler(const ClientOptions& o) : Client(o) {}
+    };
+    // Última referência solta dentro de um callback do próprio Client: o
+    // destrutor espera as threads do engine (inclusive esta), então roda em
+    // outra thread, depois que o callback retornar
+    return std::shared_ptr<Client>(new MakeSharedEnabler(options), [](Client* client) {
+        if (callback_owner == client) {
+            try {
+                std::thread([client] { delete client; }).detach();
+                return;
+            } catch (const std::system_error&) {
+            }
+        }
+        delete client;
+    });
 }
 
-Client::Client() {
+Client::Client(const ClientOptions& options) : options(options) {
     std::call_once(curl_init_flag, []() {
         curl_global_init(CURL_GLOBAL_DEFAULT);
     });
+
+    PoolOptions pool_options = options.pool;
+    // No engine reativo cada multi handle mantém seu próprio cache de conexões
+    if (options.engine == Engine::Reactor) pool_options.share_connections = false;
+
+    pool = std::make_unique<detail::ConnectionPool>(pool_options);
+    transfers = std::make_unique<detail::TransferPool>();
+    if (options.cache.enabled) {
+        cache = std::make_unique<detail::HttpCache>(options.cache, options.response_layout);
+    }
+    if (options.coalesce_requests) coalescer = std::make_unique<detail::Coalescer>();
+    if (options.collect_metrics) metrics = std::make_unique<detail::MetricsRegistry>();
+    if (options.hedging.enabled || options.adaptive_timeouts.enabled) {
+        latencies = std::make_unique<detail::LatencyTracker>();
+    }
+    if (options.hedging.enabled) {
+        hedge_budget = std::make_unique<detail::RetryBudget>(options.hedging.budget_ratio, options.hedging.budget_burst);
+        timers = std::make_unique<detail::TimerQueue>();
+    }
+    if (options.engine == Engine::Reactor) {
+        reactor = std::make_unique<detail::Reactor>(options.reactor_threads, pool_options);
+    }
 }
 
 Client::~Client() {
+    // Para os reactors primeiro: transferências pendentes são concluídas com erro
+    closing.store(true, std::memory_order_release);
+    // Hedges agendados são descartados antes de os engines pararem (a fila
+    // continua existindo para os cancel() das tentativas ainda em voo)
+    if (timers) timers->stop();
+    reactor.reset();
+    batch_reactor.reset();
+
+    std::unique_lock<std::mutex> lock(threads_mutex);
+    threads_idle.wait(lock, [this] { return threads_inflight == 0; });
+
     // Em bibliotecas, usualmente evitamos chamar curl_global_cleanup
     // para não interferir em outros usos do cURL na aplicação hospedadora.
 }
 
 std::future<Response> Client::request(const Request& req) {
-    return std::async(std::launch::async, [this, req]() -> Response {
-        Request mutable_req = req;
+    return request(Request(req));
+}
 
-        // Interceptors de saída
-        for (auto& i : interceptors) { if (i) i->on_request(mutable_req); }
+std::future<Response> Client::request(Request&& req) {
+    auto promise = std::make_shared<std::promise<Response>>();
+    auto future = promise->get_future();
+    request(std::move(req), [promise](Response res) { promise->set_value(std::move(res)); });
+    return future;
+}
 
-        Response res_obj;
-        CURL* curl = curl_easy_init();
-        struct curl_slist* header_list = nullptr;
+void Client::request(Request req, Callback on_complete) {
+    if (coalescer) {
+        std::string key = detail::Coalescer::key_of(req);
+        if (!key.empty()) {
+            // Já existe uma transferência idêntica em voo: só aguarda o resultado
+            if (coalescer->join(key, on_complete)) return;
+
+            on_complete = [this, key = std::move(key), on_complete = std::move(on_complete)](Response res) {
+                coalescer->finish(key, res);
+                on_complete(std::move(res));
+            };
+        }
+    }
 
-        if (!curl) {
-            res_obj.error_message = "Critical: Could not initialize cURL handle.";
-            return res_obj;
+    if (latencies && hedgeable(req)) {
+        std::string origin = detail::ConnectionPool::origin_of(req.url);
+
+        // Timeout adaptativo: nunca maior que o configurado na Request
+        const auto& adaptive = options.adaptive_timeouts;
+        std::chrono::microseconds observed{0};
+        if (adaptive.enabled &&
+            latencies->percentile(origin, adaptive.percentile, adaptive.min_samples, observed)) {
+            const auto scaled = static_cast<long>(std::ceil(observed.count() * adaptive.multiplier / 1000.0));
+            const long timeout = std::max<long>(scaled, static_cast<long>(adaptive.min_timeout.count()));
+            if (req.timeout_ms <= 0 || timeout < req.timeout_ms) req.timeout_ms = timeout;
         }
 
-        // --- HARDENING DE SEGURANÇA ---
-        curl_easy_setopt(curl, CURLOPT_URL, mutable_req.url.c_str());
-        curl_easy_setopt(curl, CURLOPT_PROTOCOLS, CURLPROTO_HTTP | CURLPROTO_HTTPS);
-        curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2); // mínimo TLS 1.2
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+        // Só respostas vindas da rede alimentam as latências do host. Um
+        // timeout entra como amostra censurada (a latência real é pelo menos
+        // o timeout): sem ela, um host que ficou lento estouraria para sempre
+        // o timeout encurtado, que cresce a cada estouro até caber a latência
+        // nova ou chegar em Request::timeout_ms.
+        on_complete = [this, origin, timeout_ms = req.timeout_ms, on_complete = std::move(on_complete)](Response res) {
+            if (res.error_message.empty() && res.elapsed_time > 0.0) {
+                latencies->record(origin, std::chrono::microseconds(static_cast<long long>(res.elapsed_time * 1e6)));
+            } else if (timeout_ms > 0 && res.error_message == curl_easy_strerror(CURLE_OPERATION_TIMEDOUT)) {
+                latencies->record(origin, std::chrono::milliseconds(timeout_ms));
+            }
+            on_complete(std::move(res));
+        };
 
-        // Timeouts
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, mutable_req.timeout_ms);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, mutable_req.connect_timeout_ms);
+        if (options.hedging.enabled) {
+            dispatch_hedged(std::move(req), std::move(on_complete), origin);
+            return;
+        }
+    }
 
-        // Método HTTP
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, mutable_req.method_string().c_str());
+    dispatch(std::move(req), std::move(on_complete));
+}
 
-        // Headers
-        for (const auto& kv : mutable_req.headers) {
-            std::string h = kv.first + ": " + kv.second;
-            header_list = curl_slist_append(header_list, h.c_str());
-        }
+void Client::dispatch(Request req, Callback on_complete, std::shared_ptr<std::atomic<bool>> cancel) {
+    if (reactor) {
+        submit(*reactor, *pool, std::move(req), std::move(on_complete), false, std::move(cancel));
+        return;
+    }
 
-        // Body / Payload
-        if (!mutable_req.body.empty()) {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, mutable_req.body.c_str());
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(mutable_req.body.size()));
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        ++threads_inflight;
+    }
+
+    auto finished = [this] {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        --threads_inflight;
+        threads_idle.notify_all();
+    };
 
-            if (mutable_req.headers.find("Content-Type") == mutable_req.headers.end()) {
-                header_list = curl_slist_append(header_list, "Content-Type: application/json");
+    try {
+        std::thread([this, req = std::move(req), on_complete = std::move(on_complete), finished,
+                     cancel = std::move(cancel)]() mutable {
+            {
+                // O callback (e as capturas dele) é destruído ainda dentro do escopo
+                CallbackScope scope(this);
+                Callback deliver = std::move(on_complete);
+                try {
+                    deliver(perform(std::move(req), std::move(cancel)));
+                } catch (...) {
+                }
             }
+            finished();
+        }).detach();
+    } catch (const std::system_error& e) {
+        // Sem threads disponíveis: falha a requisição em vez de propagar a exceção
+        finished();
+        Response res;
+        res.error_message = std::string("Could not start request thread: ") + e.what();
+        on_complete(std::move(res));
+    }
+}
+
+void Client::dispatch_hedged(Request req, Callback on_complete, const std::string& origin) {
+    const auto& hedging = options.hedging;
+    hedge_budget->deposit();
+
+    // Sem histórico suficiente para o host: requisição simples
+    std::chrono::microseconds delay{0};
+    if (!latencies->percentile(origin, hedging.percentile, hedging.min_samples, delay)) {
+        dispatch(std::move(req), std::move(on_complete));
+        return;
+    }
+    delay = std::clamp<std::chrono::microseconds>(delay, hedging.min_delay, hedging.max_delay);
+
+    auto state = std::make_shared<detail::HedgeState>();
+    // Corpo em memória compartilhada: a cópia da Request não duplica o upload
+    req.body.share();
+    state->backup = req;
+    state->on_complete = std::move(on_complete);
+
+    const auto timer = timers->schedule(std::chrono::steady_clock::now() + delay, [this, state] {
+        // Um hit no cache completa a tentativa nesta thread
+        CallbackScope scope(this);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->done) return;
+        }
+        // Sob sobrecarga o orçamento acaba e os hedges param de multiplicar o tráfego
+        if (!hedge_budget->try_withdraw()) {
+            budget_denied.fetch_add(1, std::memory_order_relaxed);
+            return;
         }
+        // A cópia sai do estado sob o lock: finish_attempt também a move
+        Request backup;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->done) return;
+            ++state->outstanding;
+            backup = std::move(state->backup);
+        }
+        hedged.fetch_add(1, std::memory_order_relaxed);
+        dispatch(std::move(backup),
+                 [this, state](Response res) { finish_attempt(state, 1, std::move(res)); },
+                 state->cancel[1]);
+    });
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->timer = timer;
+    }
 
-        if (header_list) curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
+    dispatch(std::move(req),
+             [this, state](Response res) { finish_attempt(state, 0, std::move(res)); },
+             state->cancel[0]);
+}
 
-        // Callbacks para corpo e headers
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &res_obj.body);
-        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &res_obj.headers);
+void Client::finish_attempt(const std::shared_ptr<detail::HedgeState>& state, int attempt, Response res) {
+    Callback on_complete;
+    detail::TimerQueue::Id timer;
+    Request backup;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done) return; // perdedora (já cancelada)
+        --state->outstanding;
+
+        // Falha de transporte com a outra tentativa ainda em voo: espera por ela
+        if (!res.error_message.empty() && state->outstanding > 0) return;
+
+        state->done = true;
+        on_complete = std::move(state->on_complete);
+        timer = state->timer;
+        backup = std::move(state->backup);
+    }
 
-        // Executa
-        CURLcode code = curl_easy_perform(curl);
+    // Hedge que não chegou a sair: a tarefa e a cópia da Request são liberadas já
+    timers->cancel(timer);
+    state->cancel[1 - attempt]->store(true, std::memory_order_relaxed);
+    if (attempt == 1) hedge_wins.fetch_add(1, std::memory_order_relaxed);
+    on_complete(std::move(res));
+}
 
-        if (code != CURLE_OK) {
-            res_obj.error_message = curl_easy_strerror(code);
-        } else {
-            long http_code = 0;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-            res_obj.status_code = static_cast<int>(http_code);
+Response Client::perform(Request req, std::shared_ptr<std::atomic<bool>> cancel) {
+    // Interceptors veem o corpo original; um Content-Encoding definido por eles desliga a compressão
+    const double request_interceptors = run_request_interceptors(req);
+    detail::compress_body(req, options.compression);
+
+    detail::Transfer t;
+    t.request = std::move(req);
+    t.queued_at = std::chrono::steady_clock::now();
+
+    // Cópia fresca no cache: nenhuma ida à rede
+    if (cache) {
+        Response cached;
+        if (cache->lookup(t.request, cached, t.cache)) {
+            cached.timings.interceptors = request_interceptors;
+            run_response_interceptors(cached);
+            return cached;
+        }
+    }
+
+    // Handle reaproveitado do pool: evita novo DNS/TCP/TLS a cada chamada
+    t.lease = pool->acquire(t.request.url);
+
+    if (!t.lease) {
+        t.response.error_message = "Critical: Could not initialize cURL handle.";
+        return std::move(t.response);
+    }
+
+    t.cancel = std::move(cancel);
+    detail::configure(t, options);
+    // Espera por vaga no pool conta como fila
+    t.started_at = std::chrono::steady_clock::now();
+    CURLcode code = curl_easy_perform(t.lease.get());
+    detail::collect(t, code);
+    // Perdedora de um hedge abortada: nem erro de transporte nem latência do host
+    if (metrics && !t.cancelled()) metrics->record(t.lease.host(), t.response);
+
+    // O handle volta para o pool; a conexão continua aberta
+    t.lease.reset();
+
+    if (cache) cache->complete(t.cache, t.response);
+    t.response.timings.interceptors = request_interceptors;
+    run_response_interceptors(t.response);
+    return std::move(t.response);
+}
 
-            double t = 0.0;
-            curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &t);
-            res_obj.elapsed_time = t;
+void Client::submit(detail::Reactor& engine, detail::ConnectionPool& handles, Request req,
+                    Callback on_complete, bool multiplex, std::shared_ptr<std::atomic<bool>> cancel) {
+    // No engine reativo os interceptors de saída e a compressão rodam na thread chamadora
+    const double request_interceptors = run_request_interceptors(req);
+    detail::compress_body(req, options.compression);
+
+    // Transfer reaproveitada da arena (volta sozinha ao terminar)
+    detail::TransferPtr t = transfers->acquire();
+    t->request = std::move(req);
+    t->queued_at = std::chrono::steady_clock::now();
+
+    if (cache) {
+        Response cached;
+        if (cache->lookup(t->request, cached, t->cache)) {
+            cached.timings.interceptors = request_interceptors;
+            run_response_interceptors(cached);
+            on_complete(std::move(cached));
+            return;
         }
+    }
+
+    t->lease = handles.acquire(t->request.url, /*wait_for_slot=*/false);
+
+    if (!t->lease) {
+        t->response.error_message = "Critical: Could not initialize cURL handle.";
+        on_complete(std::move(t->response));
+        return;
+    }
 
-        // Limpeza
-        if (header_list) curl_slist_free_all(header_list);
-        curl_easy_cleanup(curl);
+    t->multiplex = multiplex;
+    t->cancel = std::move(cancel);
+    detail::configure(*t, options);
+    t->on_done = [this, on_complete = std::move(on_complete), request_interceptors](detail::Transfer& done) mutable {
+        CallbackScope scope(this);
+        if (metrics && done.lease && !done.cancelled()) metrics->record(done.lease.host(), done.response);
+        if (cache) cache->complete(done.cache, done.response);
+        done.response.timings.interceptors = request_interceptors;
+        run_response_interceptors(done.response);
+        Callback deliver = std::move(on_complete);
+        deliver(std::move(done.response));
+    };
+    engine.submit(std::move(t));
+}
+
+// --- LOTES ---
 
-        // Interceptors de entrada
-        for (auto& i : interceptors) { if (i) i->on_response(res_obj); }
+std::future<std::vector<Response>> Client::batch(std::vector<Request> requests, const BatchOptions& batch_options) {
+    struct Collector {
+        std::promise<std::vector<Response>> promise;
+        std::vector<Response> results;
+        std::atomic<std::size_t> remaining{0};
+    };
+
+    auto collector = std::make_shared<Collector>();
+    auto future = collector->promise.get_future();
+    if (requests.empty()) {
+        collector->promise.set_value({});
+        return future;
+    }
 
-        return res_obj;
+    collector->results.resize(requests.size());
+    collector->remaining.store(requests.size(), std::memory_order_relaxed);
+    start_batch(std::move(requests), batch_options, [collector](std::size_t index, Response res) {
+        // Cada índice é escrito uma única vez; o último a terminar publica o vetor
+        collector->results[index] = std::move(res);
+        if (collector->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            collector->promise.set_value(std::move(collector->results));
+        }
     });
+    return future;
+}
+
+std::shared_ptr<BatchStream> Client::batch_stream(std::vector<Request> requests, const BatchOptions& batch_options) {
+    auto stream = std::make_shared<BatchStream>(requests.size());
+    if (!requests.empty()) {
+        start_batch(std::move(requests), batch_options, [stream](std::size_t index, Response res) {
+            stream->push(index, std::move(res));
+        });
+    }
+    return stream;
+}
+
+void Client::start_batch(std::vector<Request> requests, const BatchOptions& batch_options,
+                         std::function<void(std::size_t, Response)> deliver) {
+    auto run = std::make_shared<detail::BatchRun>();
+    run->requests = std::move(requests);
+    run->window = std::max<std::size_t>(batch_options.max_concurrency, 1);
+    run->multiplex = batch_options.multiplex;
+    run->deliver = std::move(deliver);
+
+    if (reactor) {
+        run->engine = reactor.get();
+        run->handles = pool.get();
+    } else {
+        // Engine::Threaded: reactor próprio dos lotes, com cache de conexões
+        // no multi handle (necessário para multiplexar)
+        std::call_once(batch_engine_once, [this] {
+            PoolOptions pool_options = options.pool;
+            pool_options.share_connections = false;
+            batch_pool = std::make_unique<detail::ConnectionPool>(pool_options);
+            batch_reactor = std::make_unique<detail::Reactor>(options.reactor_threads, pool_options);
+        });
+        run->engine = batch_reactor.get();
+        run->handles = batch_pool.get();
+    }
+
+    pump_batch(run);
+}
+
+void Client::pump_batch(const std::shared_ptr<detail::BatchRun>& run) {
+    {
+        std::lock_guard<std::mutex> lock(run->mutex);
+        // Outra thread (ou um nível acima desta) já está enchendo a janela
+        if (run->pumping) {
+            run->pump_again = true;
+            return;
+        }
+        run->pumping = true;
+    }
+
+    for (;;) {
+        std::size_t index = 0;
+        Request req;
+        {
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (run->next == run->requests.size() || run->in_flight >= run->window) {
+                if (run->pump_again) {
+                    run->pump_again = false;
+                    continue;
+                }
+                run->pumping = false;
+                return;
+            }
+            index = run->next++;
+            ++run->in_flight;
+            req = std::move(run->requests[index]);
+        }
+
+        auto on_complete = [this, run, index](Response res) {
+            {
+                std::lock_guard<std::mutex> lock(run->mutex);
+                --run->in_flight;
+            }
+            run->deliver(index, std::move(res));
+            pump_batch(run);
+        };
+
+        if (closing.load(std::memory_order_acquire)) {
+            Response res;
+            res.error_message = "Request cancelled: client destroyed.";
+            on_complete(std::move(res));
+            continue;
+        }
+
+        // Concluída de forma síncrona (cache, erro), o callback só marca
+        // pump_again: este laço continua sem recursão
+        submit(*run->engine, *run->handles, std::move(req), std::move(on_complete), run->multiplex);
+    }
+}
+
+double Client::run_request_interceptors(Request& req) {
+    if (interceptors.empty()) return 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& i : interceptors) { if (i) i->on_request(req); }
+    return seconds_since(start);
+}
+
+void Client::run_response_interceptors(Response& res) {
+    if (interceptors.empty()) return;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& i : interceptors) { if (i) i->on_response(res); }
+    res.timings.interceptors += seconds_since(start);
 }
 
 // Shorthands
 std::future<Response> Client::get(const std::string& url) {
-    Request r; r.url = url; r.method = Method::GET; return request(r);
+    Request r; r.url = url; r.method = Method::GET; return request(std::move(r));
+}
+
+std::future<Response> Client::get(const std::string& url, std::shared_ptr<BodySink> sink) {
+    Request r; r.url = url; r.method = Method::GET; r.sink = std::move(sink); return request(std::move(r));
 }
 
 std::future<Response> Client::post(const std::string& url, const nlohmann::json& body) {
-    Request r; r.url = url; r.method = Method::POST; r.body = body.dump(); return request(r);
+    Request r; r.url = url; r.method = Method::POST; r.body = body.dump(); return request(std::move(r));
 }
 
 std::future<Response> Client::put(const std::string& url, const nlohmann::json& body) {
-    Request r; r.url = url; r.method = Method::PUT; r.body = body.dump(); return request(r);
+    Request r; r.url = url; r.method = Method::PUT; r.body = body.dump(); return request(std::move(r));
 }
 
 std::future<Response> Client::del(const std::string& url) {
-    Request r; r.url = url; r.method = Method::DELETE_; return request(r);
+    Request r; r.url = url; r.method = Method::DELETE_; return request(std::move(r));
+}
+
+std::future<Response> Client::post(const std::string& url, Body&& body) {
+    Request r; r.url = url; r.method = Method::POST; r.body = std::move(body); return request(std::move(r));
+}
+
+std::future<Response> Client::put(const std::string& url, Body&& body) {
+    Request r; r.url = url; r.method = Method::PUT; r.body = std::move(body); return request(std::move(r));
+}
+
+// Awaitable que entrega a requisição ao engine e retoma a corrotina no callback
+namespace {
+struct ResponseAwaiter {
+    Client& client;
+    Request req;
+    Response res;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+        Executor* executor = Executor::current();
+        // O callback pode rodar antes de request() retornar: nada de tocar em
+        // *this depois desta chamada.
+        client.request(std::move(req), [this, h, executor](Response r) {
+            res = std::move(r);
+            if (executor) executor->post(h);
+            else h.resume();
+        });
+    }
+    Response await_resume() { return std::move(res); }
+};
+} // namespace
+
+Task<Response> Client::co_request(Request req) {
+    // Awaiter nomeado: mantém o estado no frame da corrotina até a retomada
+    ResponseAwaiter awaiter{*this, std::move(req), {}};
+    co_return co_await awaiter;
+}
+
+Task<Response> Client::co_get(const std::string& url) {
+    Request r; r.url = url; r.method = Method::GET; return co_request(std::move(r));
+}
+
+Task<Response> Client::co_post(const std::string& url, const nlohmann::json& body) {
+    Request r; r.url = url; r.method = Method::POST; r.body = body.dump(); return co_request(std::move(r));
+}
+
+Task<Response> Client::co_put(const std::string& url, const nlohmann::json& body) {
+    Request r; r.url = url; r.method = Method::PUT; r.body = body.dump(); return co_request(std::move(r));
+}
+
+Task<Response> Client::co_del(const std::string& url) {
+    Request r; r.url = url; r.method = Method::DELETE_; return co_request(std::move(r));
 }
 
 void Client::add_interceptor(std::unique_ptr<Interceptor> interceptor) {
     interceptors.push_back(std::move(interceptor));
 }
 
-} // namespace locosync
\ No newline at end of file
+PoolStats Client::pool_stats() const {
+    return pool->stats();
+}
+
+HedgeStats Client::hedge_stats() const {
+    HedgeStats s;
+    s.hedged = hedged.load(std::memory_order_relaxed);
+    s.hedge_wins = hedge_wins.load(std::memory_order_relaxed);
+    s.budget_denied = budget_denied.load(std::memory_order_relaxed);
+    return s;
+}
+
+CacheStats Client::cache_stats() const {
+    return cache ? cache->stats() : CacheStats{};
+}
+
+std::string Client::prometheus_metrics() const {
+    return metrics ? metrics->prometheus() : std::string{};
+}
+
+} // namespace locosync
@@ -0,0 +1,61 @@
+#include "coalescer.hpp"
+
+#include <algorithm>
+
+namespace locosync::detail {
+
+Coalescer::Coalescer(std::size_t count) {
+    count = std::max<std::size_t>(count, 1);
+    shards.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) shards.push_back(std::make_unique<Shard>());
+}
+
+std::string Coalescer::key_of(const Request& req) {
+    // Só métodos idempotentes sem efeito colateral e com resposta em memória
+    if (req.method != Method::GET || !req.body.empty() || req.sink) return {};
+
+    std::string key = req.url;
+    for (const auto& kv : req.headers) {
+        key.append("\n").append(kv.first).append(": ").append(kv.second);
+    }
+    return key;
+}
+
+Coalescer::Shard& Coalescer::shard_for(const std::string& key) {
+    return *shards[std::hash<std::string>{}(key) % shards.size()];
+}
+
+bool Coalescer::join(const std::string& key, Callback& on_complete) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.waiting.find(key);
+    if (it == shard.waiting.end()) {
+        shard.waiting.emplace(key, std::vector<Callback>{});
+        return false;
+    }
+    it->second.push_back(std::move(on_complete));
+    return true;
+}
+
+void Coalescer::finish(const std::string& key, const Response& res) {
+    std::vector<Callback> followers;
+    {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.waiting.find(key);
+        if (it == shard.waiting.end()) return;
+        followers = std::move(it->second);
+        shard.waiting.erase(it);
+    }
+
+    // Fora do lock: um callback pode disparar uma nova requisição com a mesma chave
+    for (auto& cb : followers) {
+        try {
+            cb(res);
+        } catch (...) {
+        }
+    }
+}
+
+} // namespace locosync::detail
@@ -0,0 +1,47 @@
+#ifndef LOCOSYNC_COALESCER_HPP
+#define LOCOSYNC_COALESCER_HPP
+
+#include "locosync/request.hpp"
+#include "locosync/response.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace locosync::detail {
+
+// Singleflight: requisições idênticas em voo compartilham uma única
+// transferência. O mapa é dividido em shards para reduzir a disputa de lock.
+class Coalescer {
+public:
+    using Callback = std::function<void(Response)>;
+
+    explicit Coalescer(std::size_t shards = 16);
+
+    // GET sem corpo e sem sink; string vazia se a requisição não pode ser agrupada
+    static std::string key_of(const Request& req);
+
+    // true = já existe uma transferência em voo e o callback foi anexado a ela.
+    // false = o chamador é o líder e deve chamar finish(key, ...) ao terminar.
+    bool join(const std::string& key, Callback& on_complete);
+
+    // Entrega uma cópia da resposta a cada requisição anexada
+    void finish(const std::string& key, const Response& res);
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::vector<Callback>> waiting;
+    };
+
+    Shard& shard_for(const std::string& key);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_COALESCER_HPP
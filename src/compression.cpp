@@ -0,0 +1,140 @@
+#include "compression.hpp"
+#include "locosync/response.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+#ifdef LOCOSYNC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LOCOSYNC_HAVE_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef LOCOSYNC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace locosync::detail {
+
+namespace {
+
+#ifdef LOCOSYNC_HAVE_ZLIB
+// Formato gzip (windowBits 15 + 16); a entrada vai em pedaços porque avail_in é uInt
+bool gzip(int level, std::string_view input, std::string& out) {
+    z_stream zs{};
+    if (deflateInit2(&zs, level < 0 ? Z_DEFAULT_COMPRESSION : std::min(level, 9), Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out.resize(deflateBound(&zs, static_cast<uLong>(input.size())));
+
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zs.next_out = reinterpret_cast<Bytef*>(out.data());
+    std::size_t in_left = input.size();
+    std::size_t out_left = out.size();
+    int rc = Z_OK;
+    while (rc == Z_OK) {
+        const auto in_chunk = static_cast<uInt>(std::min<std::size_t>(in_left, UINT_MAX));
+        const auto out_chunk = static_cast<uInt>(std::min<std::size_t>(out_left, UINT_MAX));
+        zs.avail_in = in_chunk;
+        zs.avail_out = out_chunk;
+        rc = deflate(&zs, in_chunk == in_left ? Z_FINISH : Z_NO_FLUSH);
+        in_left -= in_chunk - zs.avail_in;
+        out_left -= out_chunk - zs.avail_out;
+    }
+    const bool ok = rc == Z_STREAM_END;
+    out.resize(ok ? zs.total_out : 0);
+    deflateEnd(&zs);
+    return ok;
+}
+#endif
+
+#ifdef LOCOSYNC_HAVE_BROTLI
+bool brotli(int level, std::string_view input, std::string& out) {
+    // Qualidade 11 (padrão da lib) é lenta demais para o caminho da requisição
+    const int quality = level < 0 ? 5 : std::min(level, BROTLI_MAX_QUALITY);
+    std::size_t size = BrotliEncoderMaxCompressedSize(input.size());
+    if (size == 0) return false;
+    out.resize(size);
+    if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC, input.size(),
+                               reinterpret_cast<const std::uint8_t*>(input.data()), &size,
+                               reinterpret_cast<std::uint8_t*>(out.data()))) {
+        return false;
+    }
+    out.resize(size);
+    return true;
+}
+#endif
+
+#ifdef LOCOSYNC_HAVE_ZSTD
+bool zstd(int level, std::string_view input, std::string& out) {
+    out.resize(ZSTD_compressBound(input.size()));
+    const std::size_t size = ZSTD_compress(out.data(), out.size(), input.data(), input.size(),
+                                           level < 0 ? ZSTD_CLEVEL_DEFAULT : std::min(level, ZSTD_maxCLevel()));
+    if (ZSTD_isError(size)) return false;
+    out.resize(size);
+    return true;
+}
+#endif
+
+} // namespace
+
+bool encoding_available(ContentEncoding encoding) {
+    switch (encoding) {
+#ifdef LOCOSYNC_HAVE_ZLIB
+        case ContentEncoding::Gzip: return true;
+#endif
+#ifdef LOCOSYNC_HAVE_BROTLI
+        case ContentEncoding::Brotli: return true;
+#endif
+#ifdef LOCOSYNC_HAVE_ZSTD
+        case ContentEncoding::Zstd: return true;
+#endif
+        default: return false;
+    }
+}
+
+const char* encoding_token(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::Gzip:   return "gzip";
+        case ContentEncoding::Brotli: return "br";
+        case ContentEncoding::Zstd:   return "zstd";
+        default:                      return "identity";
+    }
+}
+
+bool compress(ContentEncoding encoding, [[maybe_unused]] int level, [[maybe_unused]] std::string_view input,
+              [[maybe_unused]] std::string& out) {
+    switch (encoding) {
+#ifdef LOCOSYNC_HAVE_ZLIB
+        case ContentEncoding::Gzip: return gzip(level, input, out);
+#endif
+#ifdef LOCOSYNC_HAVE_BROTLI
+        case ContentEncoding::Brotli: return brotli(level, input, out);
+#endif
+#ifdef LOCOSYNC_HAVE_ZSTD
+        case ContentEncoding::Zstd: return zstd(level, input, out);
+#endif
+        default: return false;
+    }
+}
+
+void compress_body(Request& req, const CompressionOptions& options) {
+    if (options.request_encoding == ContentEncoding::Identity) return;
+    if (req.body.empty() || req.body.size() < options.request_min_bytes) return;
+    if (!encoding_available(options.request_encoding)) return;
+    for (const auto& kv : req.headers) {
+        if (iequals(kv.first, "Content-Encoding")) return;
+    }
+
+    std::string compressed;
+    if (!compress(options.request_encoding, options.level, req.body.view(), compressed)) return;
+    // Dados já comprimidos (imagens, arquivos .gz) não ganham nada
+    if (compressed.size() >= req.body.size()) return;
+
+    req.body = Body(std::move(compressed));
+    req.headers["Content-Encoding"] = encoding_token(options.request_encoding);
+}
+
+} // namespace locosync::detail
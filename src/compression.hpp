@@ -0,0 +1,27 @@
+#ifndef LOCOSYNC_COMPRESSION_HPP
+#define LOCOSYNC_COMPRESSION_HPP
+
+#include "locosync/options.hpp"
+#include "locosync/request.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace locosync::detail {
+
+// Algoritmo compilado neste build (LOCOSYNC_HAVE_ZLIB / _BROTLI / _ZSTD)
+bool encoding_available(ContentEncoding encoding);
+
+// Token do header Content-Encoding ("gzip", "br", "zstd")
+const char* encoding_token(ContentEncoding encoding);
+
+// Comprime `input` inteiro em `out`; false se o algoritmo não está disponível ou falhou
+bool compress(ContentEncoding encoding, int level, std::string_view input, std::string& out);
+
+// Aplica CompressionOptions ao corpo: troca o Body pelo comprimido e adiciona
+// Content-Encoding. Não mexe em requisições que já definem Content-Encoding.
+void compress_body(Request& req, const CompressionOptions& options);
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_COMPRESSION_HPP
@@ -0,0 +1,198 @@
+#include "connection_pool.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace locosync::detail {
+
+// --- Lease ---
+
+Lease::Lease(ConnectionPool* pool, std::string origin, CURL* handle)
+    : pool(pool), origin(std::move(origin)), handle(handle) {}
+
+Lease::Lease(Lease&& other) noexcept
+    : pool(other.pool), origin(std::move(other.origin)), handle(other.handle) {
+    other.pool = nullptr;
+    other.handle = nullptr;
+}
+
+Lease& Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool = other.pool;
+        origin = std::move(other.origin);
+        handle = other.handle;
+        other.pool = nullptr;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Lease::~Lease() { reset(); }
+
+void Lease::reset() {
+    if (pool && handle) pool->release(origin, handle);
+    pool = nullptr;
+    handle = nullptr;
+}
+
+// --- ConnectionPool ---
+
+ConnectionPool::ConnectionPool(const PoolOptions& options) : options(options) {
+    share = curl_share_init();
+    if (!share) return;
+
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &ConnectionPool::lock_share);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &ConnectionPool::unlock_share);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+
+    if (options.share_dns) curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    if (options.share_tls_sessions) curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    if (options.share_connections) curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
+
+ConnectionPool::~ConnectionPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [origin, slot] : hosts) {
+            for (auto& idle : slot.idle) curl_easy_cleanup(idle.handle);
+            slot.idle.clear();
+        }
+        hosts.clear();
+    }
+    // Só é seguro liberar o share depois que nenhum easy handle o referencia
+    if (share) curl_share_cleanup(share);
+}
+
+void ConnectionPool::lock_share(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+    auto* self = static_cast<ConnectionPool*>(userptr);
+    self->share_locks[static_cast<std::size_t>(data) % self->share_locks.size()].lock();
+}
+
+void ConnectionPool::unlock_share(CURL*, curl_lock_data data, void* userptr) {
+    auto* self = static_cast<ConnectionPool*>(userptr);
+    self->share_locks[static_cast<std::size_t>(data) % self->share_locks.size()].unlock();
+}
+
+std::string ConnectionPool::origin_of(const std::string& url) {
+    CURLU* u = curl_url();
+    if (!u) return {};
+
+    std::string origin;
+    if (curl_url_set(u, CURLUPART_URL, url.c_str(), 0) == CURLUE_OK) {
+        char* scheme = nullptr;
+        char* host = nullptr;
+        char* port = nullptr;
+        curl_url_get(u, CURLUPART_SCHEME, &scheme, 0);
+        curl_url_get(u, CURLUPART_HOST, &host, 0);
+        curl_url_get(u, CURLUPART_PORT, &port, CURLU_DEFAULT_PORT);
+
+        if (scheme && host) {
+            origin.append(scheme).append("://").append(host);
+            if (port) origin.append(":").append(port);
+            std::transform(origin.begin(), origin.end(), origin.begin(),
+                           [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+        }
+        curl_free(scheme);
+        curl_free(host);
+        curl_free(port);
+    }
+    curl_url_cleanup(u);
+    return origin;
+}
+
+CURL* ConnectionPool::create_handle() {
+    CURL* handle = curl_easy_init();
+    if (!handle) return nullptr;
+    // Opções persistentes: sobrevivem ao curl_easy_reset() feito na devolução
+    if (share) curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    return handle;
+}
+
+void ConnectionPool::evict_expired(HostSlot& slot, std::chrono::steady_clock::time_point now) {
+    auto expired = [&](const IdleHandle& idle) { return now - idle.since > options.idle_timeout; };
+    auto it = std::stable_partition(slot.idle.begin(), slot.idle.end(),
+                                    [&](const IdleHandle& idle) { return !expired(idle); });
+    for (auto e = it; e != slot.idle.end(); ++e) {
+        curl_easy_cleanup(e->handle);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.idle.erase(it, slot.idle.end());
+}
+
+Lease ConnectionPool::acquire(const std::string& url, bool wait_for_slot) {
+    std::string origin = origin_of(url);
+    const auto now = std::chrono::steady_clock::now();
+
+    CURL* handle = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        HostSlot& slot = hosts[origin];
+
+        if (wait_for_slot && options.max_connections_per_host > 0) {
+            slot_freed.wait(lock, [&] { return slot.in_use < options.max_connections_per_host; });
+        }
+
+        evict_expired(slot, now);
+        if (!slot.idle.empty()) {
+            // LIFO: o handle mais recente tem maior chance de ter a conexão viva
+            handle = slot.idle.back().handle;
+            slot.idle.pop_back();
+        }
+        ++slot.in_use;
+    }
+
+    if (handle) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        handle = create_handle();
+        if (!handle) {
+            std::lock_guard<std::mutex> lock(mutex);
+            --hosts[origin].in_use;
+            slot_freed.notify_all();
+            return {};
+        }
+    }
+    return Lease(this, std::move(origin), handle);
+}
+
+void ConnectionPool::release(const std::string& origin, CURL* handle) {
+    // Limpa ponteiros para buffers da requisição anterior; conexões, cache de
+    // DNS, sessões TLS e o share permanecem no handle.
+    curl_easy_reset(handle);
+
+    CURL* discard = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        HostSlot& slot = hosts[origin];
+        if (slot.in_use > 0) --slot.in_use;
+        if (slot.idle.size() < options.max_idle_per_host) {
+            slot.idle.push_back({handle, std::chrono::steady_clock::now()});
+        } else {
+            discard = handle;
+        }
+    }
+    slot_freed.notify_all();
+
+    if (discard) {
+        curl_easy_cleanup(discard);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PoolStats ConnectionPool::stats() const {
+    PoolStats s;
+    s.hits = hits.load(std::memory_order_relaxed);
+    s.misses = misses.load(std::memory_order_relaxed);
+    s.evictions = evictions.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [origin, slot] : hosts) {
+        s.idle += slot.idle.size();
+        s.in_use += slot.in_use;
+    }
+    return s;
+}
+
+} // namespace locosync::detail
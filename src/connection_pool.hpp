@@ -0,0 +1,100 @@
+#ifndef LOCOSYNC_CONNECTION_POOL_HPP
+#define LOCOSYNC_CONNECTION_POOL_HPP
+
+#include "locosync/options.hpp"
+
+#include <curl/curl.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace locosync::detail {
+
+class ConnectionPool;
+
+// Handle emprestado do pool; devolvido automaticamente no destrutor (RAII)
+class Lease {
+public:
+    Lease() = default;
+    Lease(ConnectionPool* pool, std::string origin, CURL* handle);
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease();
+
+    CURL* get() const { return handle; }
+    explicit operator bool() const { return handle != nullptr; }
+
+    // Origem (scheme://host:port) à qual o handle pertence
+    const std::string& host() const { return origin; }
+
+    // Devolve o handle ao pool antes do destrutor
+    void reset();
+
+private:
+    ConnectionPool* pool{nullptr};
+    std::string origin;
+    CURL* handle{nullptr};
+};
+
+// Pool de easy handles por origem (scheme://host:port) com um objeto CURLSH
+// compartilhando cache de DNS, sessões TLS e conexões.
+class ConnectionPool {
+public:
+    explicit ConnectionPool(const PoolOptions& options);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Com wait_for_slot, bloqueia enquanto o limite por host estiver esgotado.
+    // O engine reativo passa false: o limite é aplicado pelo próprio multi handle.
+    Lease acquire(const std::string& url, bool wait_for_slot = true);
+
+    PoolStats stats() const;
+
+    // "scheme://host:port" normalizado; string vazia se a URL for inválida
+    static std::string origin_of(const std::string& url);
+
+private:
+    friend class Lease;
+
+    struct IdleHandle {
+        CURL* handle;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    struct HostSlot {
+        std::vector<IdleHandle> idle;
+        std::size_t in_use{0};
+    };
+
+    CURL* create_handle();
+    void release(const std::string& origin, CURL* handle);
+    void evict_expired(HostSlot& slot, std::chrono::steady_clock::time_point now);
+
+    static void lock_share(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+    static void unlock_share(CURL* handle, curl_lock_data data, void* userptr);
+
+    PoolOptions options;
+    CURLSH* share{nullptr};
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> share_locks;
+
+    mutable std::mutex mutex;
+    std::condition_variable slot_freed;
+    std::unordered_map<std::string, HostSlot> hosts;
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_CONNECTION_POOL_HPP
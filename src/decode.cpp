@@ -0,0 +1,147 @@
+#include "locosync/decode.hpp"
+
+#include <vector>
+
+namespace locosync::detail {
+
+namespace {
+
+using json = nlohmann::json;
+
+// Handler SAX que escreve cada valor direto no destino tipado. Uma pilha de
+// containers abertos substitui o DOM; subárvores sem destino são puladas.
+class TypedSax final : public nlohmann::json_sax<json> {
+public:
+    TypedSax(Dest root, std::string& error) : root(root), error(error) {}
+
+    bool null() override { return value(Scalar{}); }
+
+    bool boolean(bool val) override {
+        Scalar s;
+        s.kind = Scalar::Kind::Bool;
+        s.boolean = val;
+        return value(s);
+    }
+
+    bool number_integer(number_integer_t val) override {
+        Scalar s;
+        s.kind = Scalar::Kind::Int;
+        s.integer = val;
+        return value(s);
+    }
+
+    bool number_unsigned(number_unsigned_t val) override {
+        Scalar s;
+        s.kind = Scalar::Kind::Uint;
+        s.unsigned_integer = val;
+        return value(s);
+    }
+
+    bool number_float(number_float_t val, const string_t&) override {
+        Scalar s;
+        s.kind = Scalar::Kind::Float;
+        s.floating = val;
+        return value(s);
+    }
+
+    bool string(string_t& val) override {
+        Scalar s;
+        s.kind = Scalar::Kind::String;
+        s.string = &val;
+        return value(s);
+    }
+
+    bool binary(binary_t&) override { return fail("unexpected binary value"); }
+
+    bool start_object(std::size_t) override { return open(false); }
+    bool start_array(std::size_t) override { return open(true); }
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t& val) override {
+        if (skip_depth > 0) return true;
+        const Frame& top = stack.back();
+        field = top.ops->child(top.target, val);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+
+private:
+    struct Frame {
+        void* target;
+        const TypeOps* ops;
+        bool array;
+    };
+
+    // Destino do valor que está começando
+    Dest next() {
+        if (stack.empty()) return std::exchange(root, Dest{});
+        const Frame& top = stack.back();
+        if (top.array) return top.ops->child(top.target, {});
+        return std::exchange(field, Dest{});
+    }
+
+    bool value(Scalar& s) {
+        if (skip_depth > 0) return true;
+        const Dest dest = next();
+        if (!dest.target) return true; // chave desconhecida
+        if (!dest.ops->scalar(dest.target, s)) return mismatch(*dest.ops);
+        return true;
+    }
+
+    bool value(Scalar&& s) { return value(s); }
+
+    bool open(bool array) {
+        if (skip_depth > 0) {
+            ++skip_depth;
+            return true;
+        }
+        const Dest dest = next();
+        if (!dest.target) {
+            skip_depth = 1;
+            return true;
+        }
+        Dest frame;
+        if (!dest.ops->open(dest.target, array, frame)) return mismatch(*dest.ops);
+        stack.push_back({frame.target, frame.ops, array});
+        return true;
+    }
+
+    bool close() {
+        if (skip_depth > 0) {
+            --skip_depth;
+            return true;
+        }
+        stack.pop_back();
+        return true;
+    }
+
+    bool mismatch(const TypeOps& ops) {
+        return fail(std::string("unexpected JSON type: expected ") + ops.expected);
+    }
+
+    bool fail(std::string message) {
+        if (error.empty()) error = std::move(message);
+        return false;
+    }
+
+    Dest root;
+    Dest field;
+    std::vector<Frame> stack;
+    std::size_t skip_depth{0};
+    std::string& error;
+};
+
+} // namespace
+
+bool decode_json(std::string_view text, Dest root, std::string& error) {
+    TypedSax sax(root, error);
+    const bool ok = json::sax_parse(text.begin(), text.end(), &sax);
+    if (!ok && error.empty()) error = "invalid JSON";
+    return ok;
+}
+
+} // namespace locosync::detail
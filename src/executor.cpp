@@ -0,0 +1,39 @@
+#include "locosync/executor.hpp"
+
+namespace locosync {
+
+// Executor que está dentro de run() nesta thread
+static thread_local Executor* current_executor = nullptr;
+
+void Executor::post(std::coroutine_handle<> h) {
+    // notify sob o lock: a última retomada pode terminar run() e destruir o
+    // Executor assim que o lock for solto
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(h);
+    ready.notify_one();
+}
+
+Executor* Executor::current() noexcept {
+    return current_executor;
+}
+
+Executor* Executor::exchange_current(Executor* executor) noexcept {
+    Executor* previous = current_executor;
+    current_executor = executor;
+    return previous;
+}
+
+void Executor::drive(const bool& done) {
+    while (!done) {
+        std::coroutine_handle<> h;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return !queue.empty(); });
+            h = queue.front();
+            queue.pop_front();
+        }
+        h.resume();
+    }
+}
+
+} // namespace locosync
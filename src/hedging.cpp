@@ -0,0 +1,134 @@
+#include "hedging.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace locosync::detail {
+
+// --- LatencyTracker ---
+
+LatencyTracker::Host& LatencyTracker::host(const std::string& origin) {
+    std::lock_guard<std::mutex> lock(hosts_mutex);
+    auto& slot = hosts[origin];
+    if (!slot) slot = std::make_unique<Host>();
+    return *slot;
+}
+
+void LatencyTracker::record(const std::string& origin, std::chrono::microseconds latency) {
+    Host& h = host(origin);
+    const auto us = static_cast<std::uint32_t>(std::clamp<std::int64_t>(latency.count(), 0, UINT32_MAX));
+
+    std::lock_guard<std::mutex> lock(h.mutex);
+    h.samples[h.next] = us;
+    h.next = (h.next + 1) % kWindow;
+    h.count = std::min(h.count + 1, kWindow);
+    ++h.dirty;
+}
+
+bool LatencyTracker::percentile(const std::string& origin, double p, std::size_t min_samples,
+                                std::chrono::microseconds& out) {
+    Host& h = host(origin);
+
+    std::lock_guard<std::mutex> lock(h.mutex);
+    if (h.count == 0 || h.count < min_samples) return false;
+
+    if (h.sorted.size() != h.count || h.dirty >= kRefreshEvery) {
+        h.sorted.assign(h.samples.begin(), h.samples.begin() + static_cast<std::ptrdiff_t>(h.count));
+        std::sort(h.sorted.begin(), h.sorted.end());
+        h.dirty = 0;
+    }
+
+    const double rank = std::clamp(p, 0.0, 1.0) * static_cast<double>(h.count - 1);
+    out = std::chrono::microseconds(h.sorted[static_cast<std::size_t>(std::ceil(rank))]);
+    return true;
+}
+
+// --- RetryBudget ---
+
+void RetryBudget::deposit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    tokens = std::min(burst, tokens + ratio);
+}
+
+bool RetryBudget::try_withdraw() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tokens < 1.0) return false;
+    tokens -= 1.0;
+    return true;
+}
+
+// --- TimerQueue ---
+
+TimerQueue::TimerQueue() {
+    worker = std::thread([this] { run(); });
+}
+
+TimerQueue::~TimerQueue() {
+    stop();
+}
+
+void TimerQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    if (worker.joinable()) worker.join();
+
+    std::map<Id, std::function<void()>> dropped;
+    std::lock_guard<std::mutex> lock(mutex);
+    dropped.swap(entries);
+}
+
+TimerQueue::Id TimerQueue::schedule(std::chrono::steady_clock::time_point when, std::function<void()> task) {
+    Id id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = Id{when, sequence++};
+        entries.emplace(id, std::move(task));
+    }
+    changed.notify_one();
+    return id;
+}
+
+void TimerQueue::cancel(const Id& id) {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(id);
+        if (it == entries.end()) return;
+        task = std::move(it->second);
+        entries.erase(it);
+    }
+    // As capturas da tarefa são destruídas fora do lock
+}
+
+void TimerQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (entries.empty()) {
+            changed.wait(lock);
+            continue;
+        }
+
+        auto first = entries.begin();
+        const auto when = first->first.first;
+        if (std::chrono::steady_clock::now() < when) {
+            changed.wait_until(lock, when);
+            continue;
+        }
+
+        std::function<void()> task = std::move(first->second);
+        entries.erase(first);
+
+        lock.unlock();
+        try {
+            task();
+        } catch (...) {
+        }
+        task = nullptr; // capturas liberadas fora do lock
+        lock.lock();
+    }
+}
+
+} // namespace locosync::detail
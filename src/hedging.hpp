@@ -0,0 +1,103 @@
+#ifndef LOCOSYNC_HEDGING_HPP
+#define LOCOSYNC_HEDGING_HPP
+
+#include "locosync/options.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace locosync::detail {
+
+// Latências recentes por host (ring buffer) e os percentis derivados delas.
+// Os percentis são recalculados a cada poucas amostras, não a cada consulta.
+class LatencyTracker {
+public:
+    void record(const std::string& origin, std::chrono::microseconds latency);
+
+    // Percentil `p` (0..1) do host; false se houver menos de `min_samples`
+    bool percentile(const std::string& origin, double p, std::size_t min_samples,
+                    std::chrono::microseconds& out);
+
+private:
+    static constexpr std::size_t kWindow = 512;
+    static constexpr std::size_t kRefreshEvery = 16;
+
+    struct Host {
+        std::mutex mutex;
+        std::array<std::uint32_t, kWindow> samples{}; // microssegundos
+        std::size_t count{0};
+        std::size_t next{0};
+        std::size_t dirty{0};
+        std::vector<std::uint32_t> sorted; // cópia ordenada para os percentis
+    };
+
+    Host& host(const std::string& origin);
+
+    std::mutex hosts_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Host>> hosts;
+};
+
+// Token bucket que limita o tráfego extra gerado por hedges
+class RetryBudget {
+public:
+    RetryBudget(double ratio, double burst) : ratio(ratio), burst(burst), tokens(burst) {}
+
+    // Cada requisição original deposita `ratio` fichas
+    void deposit();
+
+    // Um hedge só sai se houver uma ficha inteira
+    bool try_withdraw();
+
+private:
+    std::mutex mutex;
+    double ratio;
+    double burst;
+    double tokens;
+};
+
+// Thread única que dispara tarefas agendadas (hedges). Tarefas pendentes são
+// descartadas na destruição.
+class TimerQueue {
+public:
+    // Instante + sequência: identifica a tarefa e desempata (FIFO) o mesmo instante
+    using Id = std::pair<std::chrono::steady_clock::time_point, std::uint64_t>;
+
+    TimerQueue();
+    ~TimerQueue();
+
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+
+    Id schedule(std::chrono::steady_clock::time_point when, std::function<void()> task);
+
+    // Descarta uma tarefa que ainda não rodou (e o que ela captura)
+    void cancel(const Id& id);
+
+    // Para a thread e descarta as pendentes; schedule() depois disso não dispara
+    void stop();
+
+private:
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<Id, std::function<void()>> entries;
+    std::uint64_t sequence{0};
+    bool stopping{false};
+    std::thread worker;
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_HEDGING_HPP
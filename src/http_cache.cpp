@@ -0,0 +1,685 @@
+#include "http_cache.hpp"
+
+#include <curl/curl.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace locosync::detail {
+
+namespace {
+
+std::int64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+bool parse_int(std::string_view s, std::int64_t& out) {
+    s = trim(s);
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') s = s.substr(1, s.size() - 2);
+    auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc() && end == s.data() + s.size();
+}
+
+// Data HTTP (RFC 7231) em epoch; -1 se ausente ou inválida
+std::int64_t header_date(const Response& res, std::string_view name) {
+    const std::string_view value = res.header(name);
+    if (value.empty()) return -1;
+    return static_cast<std::int64_t>(curl_getdate(std::string(value).c_str(), nullptr));
+}
+
+struct CacheControl {
+    bool no_store{false};
+    bool no_cache{false};
+    bool has_max_age{false};
+    std::int64_t max_age{0};
+};
+
+CacheControl parse_cache_control(std::string_view value) {
+    CacheControl cc;
+    while (!value.empty()) {
+        const std::size_t comma = value.find(',');
+        const std::string_view item = trim(value.substr(0, comma));
+        value = comma == std::string_view::npos ? std::string_view{} : value.substr(comma + 1);
+
+        const std::size_t eq = item.find('=');
+        const std::string_view name = trim(item.substr(0, eq));
+        if (iequals(name, "no-store")) {
+            cc.no_store = true;
+        } else if (iequals(name, "no-cache")) {
+            cc.no_cache = true;
+        } else if (iequals(name, "max-age") && eq != std::string_view::npos) {
+            cc.has_max_age = parse_int(item.substr(eq + 1), cc.max_age);
+        }
+    }
+    return cc;
+}
+
+struct Freshness {
+    bool storable{false};
+    std::int64_t expires_at{0};
+};
+
+// Tempo de vida segundo Cache-Control/Expires/Age. `previous` fornece as
+// diretivas quando um 304 não as repete.
+Freshness freshness_of(const Response& res, const Response* previous, std::int64_t now) {
+    Freshness f;
+    const Response& policy = (previous && res.header("Cache-Control").empty() && res.header("Expires").empty())
+                                 ? *previous : res;
+
+    const CacheControl cc = parse_cache_control(policy.header("Cache-Control"));
+    if (cc.no_store || policy.header("Vary") == "*") return f;
+
+    std::int64_t lifetime = 0;
+    if (cc.has_max_age) {
+        lifetime = cc.max_age;
+    } else {
+        const std::int64_t expires = header_date(policy, "Expires");
+        if (expires >= 0) {
+            const std::int64_t date = header_date(res, "Date");
+            lifetime = expires - (date >= 0 ? date : now);
+        }
+    }
+
+    std::int64_t age = 0;
+    if (!parse_int(res.header("Age"), age) || age < 0) age = 0;
+    if (cc.no_cache) lifetime = 0;
+
+    f.expires_at = now + std::max<std::int64_t>(0, lifetime - age);
+    const bool has_validator = !policy.header("ETag").empty() || !policy.header("Last-Modified").empty();
+    f.storable = lifetime - age > 0 || has_validator;
+    return f;
+}
+
+std::size_t response_bytes(const Response& res) {
+    std::size_t bytes = sizeof(Response) + res.body.size() + res.raw_headers.size() +
+                        res.header_index.size() * sizeof(HeaderSpan);
+    for (const auto& [name, value] : res.headers) bytes += name.size() + value.size() + 64;
+    return bytes;
+}
+
+void add_header(Response& res, std::string_view name, std::string_view value, bool flat) {
+    if (!flat) {
+        res.headers.insert_or_assign(std::string(name), std::string(value));
+        return;
+    }
+    HeaderSpan span;
+    span.name_offset = static_cast<std::uint32_t>(res.raw_headers.size());
+    span.name_size = static_cast<std::uint32_t>(name.size());
+    res.raw_headers.append(name);
+    span.value_offset = static_cast<std::uint32_t>(res.raw_headers.size());
+    span.value_size = static_cast<std::uint32_t>(value.size());
+    res.raw_headers.append(value);
+    res.header_index.push_back(span);
+}
+
+std::shared_ptr<CacheEntry> make_entry(std::shared_ptr<const Response> res, std::int64_t expires_at,
+                                       std::size_t key_size) {
+    auto entry = std::make_shared<CacheEntry>();
+    entry->etag = std::string(res->header("ETag"));
+    entry->last_modified = std::string(res->header("Last-Modified"));
+    entry->expires_at = expires_at;
+    entry->bytes = response_bytes(*res) + key_size + sizeof(CacheEntry);
+    entry->response = std::move(res);
+    return entry;
+}
+
+bool has_header(const Request& req, std::string_view name) {
+    for (const auto& kv : req.headers) {
+        if (iequals(kv.first, name)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// --- CAMADA EM DISCO ---
+//
+// Arquivo append-only: cabeçalho "LOCOSC01" seguido de registros
+// [RecordHeader][chave][headers "nome\0valor\0"...][corpo]. O último registro
+// de uma chave vence; status 0 marca remoção. Uma cauda truncada (queda no
+// meio da escrita) é descartada na abertura, e o arquivo é compactado quando
+// mais da metade dele é lixo. Ao atingir max_disk_bytes novas entradas
+// deixam de ser gravadas até a próxima compactação.
+//
+// As gravações são assíncronas: complete() (no Reactor, dentro do event loop)
+// só enfileira, e a thread `writer` faz os pwrite. Enquanto pendente, uma
+// entrada é servida pela própria fila.
+
+#ifndef _WIN32
+
+class HttpCache::DiskTier {
+public:
+    DiskTier(std::string path, std::size_t max_bytes) : path(std::move(path)), max_bytes(max_bytes) {
+        open_file();
+        if (fd >= 0) writer = std::thread([this] { write_loop(); });
+    }
+
+    // Grava o que ainda está na fila antes de fechar
+    ~DiskTier() {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            stopping = true;
+        }
+        queued.notify_all();
+        if (writer.joinable()) writer.join();
+        close_file();
+    }
+
+    bool ok() const { return fd >= 0; }
+
+    std::shared_ptr<const CacheEntry> load(const std::string& key, bool flat) {
+        {
+            // Gravação ainda na fila: a versão mais nova da chave está lá
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            for (auto it = jobs.rbegin(); it != jobs.rend(); ++it) {
+                if (it->key == key) return it->entry;
+            }
+            if (in_flight && in_flight->key == key) return in_flight->entry;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end() || !ensure_mapped(it->second.offset + it->second.size)) return nullptr;
+
+        const char* p = map + it->second.offset;
+        RecordHeader h;
+        std::memcpy(&h, p, sizeof(h));
+        p += sizeof(h) + h.key_size;
+
+        auto res = std::make_shared<Response>();
+        res->status_code = h.status;
+        std::string_view headers(p, h.headers_size);
+        while (!headers.empty()) {
+            const std::size_t name_end = headers.find('\0');
+            const std::size_t value_end = headers.find('\0', name_end + 1);
+            if (name_end == std::string_view::npos || value_end == std::string_view::npos) break;
+            add_header(*res, headers.substr(0, name_end), headers.substr(name_end + 1, value_end - name_end - 1), flat);
+            headers.remove_prefix(value_end + 1);
+        }
+        p += h.headers_size;
+        res->body.assign(p, h.body_size);
+
+        return make_entry(std::move(res), h.expires_at, key.size());
+    }
+
+    void store(const std::string& key, std::shared_ptr<const CacheEntry> entry) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            // Disco lento demais: a entrada fica só na memória
+            if (queued_bytes + entry->bytes > kMaxQueuedBytes) return;
+            queued_bytes += entry->bytes;
+            jobs.push_back({key, std::move(entry)});
+        }
+        queued.notify_one();
+    }
+
+    // Remoção nunca é descartada: senão uma versão antiga voltaria do disco
+    void remove(const std::string& key) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            jobs.push_back({key, nullptr});
+        }
+        queued.notify_one();
+    }
+
+    // Espera a fila de gravações esvaziar
+    void flush() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        drained.wait(lock, [this] { return jobs.empty() && !in_flight; });
+    }
+
+private:
+    static constexpr char kFileMagic[8] = {'L', 'O', 'C', 'O', 'S', 'C', '0', '1'};
+    static constexpr std::uint32_t kRecordMagic = 0x5243534C; // "LSCR"
+    static constexpr std::size_t kMaxQueuedBytes = 64 * 1024 * 1024;
+
+    struct RecordHeader {
+        std::uint32_t magic{kRecordMagic};
+        std::uint32_t key_size{0};
+        std::uint32_t headers_size{0};
+        std::int32_t status{0};
+        std::uint64_t body_size{0};
+        std::int64_t expires_at{0};
+    };
+
+    struct Location {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    // entry nulo = remoção
+    struct Job {
+        std::string key;
+        std::shared_ptr<const CacheEntry> entry;
+    };
+
+    void write_loop() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        for (;;) {
+            queued.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // stopping, fila vazia
+
+            in_flight = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            if (in_flight->entry) write_entry(in_flight->key, *in_flight->entry);
+            else write_removal(in_flight->key);
+            lock.lock();
+
+            if (in_flight->entry) queued_bytes -= in_flight->entry->bytes;
+            in_flight.reset();
+            if (jobs.empty()) drained.notify_all();
+        }
+    }
+
+    void write_entry(const std::string& key, const CacheEntry& entry) {
+        const Response& res = *entry.response;
+
+        std::string prefix(sizeof(RecordHeader), '\0');
+        prefix.append(key);
+        for (std::size_t i = 0; i < res.header_count(); ++i) {
+            auto [name, value] = res.header_at(i);
+            prefix.append(name).push_back('\0');
+            prefix.append(value).push_back('\0');
+        }
+
+        RecordHeader h;
+        h.key_size = static_cast<std::uint32_t>(key.size());
+        h.headers_size = static_cast<std::uint32_t>(prefix.size() - sizeof(RecordHeader) - key.size());
+        h.status = res.status_code;
+        h.body_size = res.body.size();
+        h.expires_at = entry.expires_at;
+        std::memcpy(prefix.data(), &h, sizeof(h));
+        append(key, prefix, res.body);
+    }
+
+    void write_removal(const std::string& key) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (index.find(key) == index.end()) return;
+        }
+
+        std::string prefix(sizeof(RecordHeader), '\0');
+        prefix.append(key);
+        RecordHeader h;
+        h.key_size = static_cast<std::uint32_t>(key.size());
+        h.status = 0;
+        std::memcpy(prefix.data(), &h, sizeof(h));
+        append(key, prefix, {});
+    }
+
+    void open_file() {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) return;
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) return close_file();
+        end = static_cast<std::size_t>(st.st_size);
+
+        // Arquivo novo ou de outro formato: recomeça vazio
+        char magic[sizeof(kFileMagic)] = {};
+        if (end < sizeof(kFileMagic) || ::pread(fd, magic, sizeof(magic), 0) != static_cast<ssize_t>(sizeof(magic)) ||
+            std::memcmp(magic, kFileMagic, sizeof(magic)) != 0) {
+            if (::ftruncate(fd, 0) != 0 ||
+                ::pwrite(fd, kFileMagic, sizeof(kFileMagic), 0) != static_cast<ssize_t>(sizeof(kFileMagic))) {
+                return close_file();
+            }
+            end = sizeof(kFileMagic);
+        }
+
+        scan();
+
+        // Mais da metade do arquivo é lixo (versões antigas/remoções): compacta
+        if (end - sizeof(kFileMagic) > 2 * live_bytes + (1u << 20)) compact();
+    }
+
+    void close_file() {
+        unmap();
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        index.clear();
+        live_bytes = 0;
+    }
+
+    void scan() {
+        index.clear();
+        live_bytes = 0;
+        if (!ensure_mapped(end)) return close_file();
+
+        std::size_t pos = sizeof(kFileMagic);
+        while (pos + sizeof(RecordHeader) <= end) {
+            RecordHeader h;
+            std::memcpy(&h, map + pos, sizeof(h));
+            const std::size_t size = sizeof(h) + h.key_size + h.headers_size + h.body_size;
+            if (h.magic != kRecordMagic || h.body_size > end || pos + size > end) break;
+
+            std::string key(map + pos + sizeof(h), h.key_size);
+            auto it = index.find(key);
+            if (it != index.end()) {
+                live_bytes -= it->second.size;
+                index.erase(it);
+            }
+            if (h.status != 0) {
+                index.emplace(std::move(key), Location{pos, size});
+                live_bytes += size;
+            }
+            pos += size;
+        }
+
+        // Cauda incompleta de uma escrita interrompida
+        if (pos < end) {
+            unmap();
+            if (::ftruncate(fd, static_cast<off_t>(pos)) != 0) return close_file();
+            end = pos;
+        }
+    }
+
+    void compact() {
+        if (!ensure_mapped(end)) return;
+
+        const std::string tmp_path = path + ".tmp";
+        const int out = ::open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (out < 0) return;
+
+        bool good = ::write(out, kFileMagic, sizeof(kFileMagic)) == static_cast<ssize_t>(sizeof(kFileMagic));
+        for (const auto& [key, loc] : index) {
+            if (!good) break;
+            good = ::write(out, map + loc.offset, loc.size) == static_cast<ssize_t>(loc.size);
+        }
+        good = good && ::fsync(out) == 0;
+        ::close(out);
+
+        if (!good || ::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            ::unlink(tmp_path.c_str());
+            return;
+        }
+
+        close_file();
+        open_file();
+    }
+
+    // Só a thread writer chama: `end` só muda aqui, então os pwrite rodam sem
+    // o lock e load() não espera por eles
+    void append(const std::string& key, const std::string& prefix, std::string_view body) {
+        if (fd < 0) return;
+        const std::size_t size = prefix.size() + body.size();
+        if (end + size > max_bytes) return;
+
+        const bool good =
+            ::pwrite(fd, prefix.data(), prefix.size(), static_cast<off_t>(end)) == static_cast<ssize_t>(prefix.size()) &&
+            (body.empty() ||
+             ::pwrite(fd, body.data(), body.size(), static_cast<off_t>(end + prefix.size())) ==
+                 static_cast<ssize_t>(body.size()));
+        if (!good) {
+            // Não deixa um registro pela metade no meio do arquivo
+            [[maybe_unused]] int r = ::ftruncate(fd, static_cast<off_t>(end));
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            live_bytes -= it->second.size;
+            index.erase(it);
+        }
+        RecordHeader h;
+        std::memcpy(&h, prefix.data(), sizeof(h));
+        if (h.status != 0) {
+            index.emplace(key, Location{end, size});
+            live_bytes += size;
+        }
+        end += size;
+    }
+
+    // Garante que [0, need) está mapeado; remapeia depois de novos appends
+    bool ensure_mapped(std::size_t need) {
+        if (need <= map_size) return true;
+        unmap();
+        void* address = ::mmap(nullptr, end, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) return false;
+        map = static_cast<const char*>(address);
+        map_size = end;
+        return need <= map_size;
+    }
+
+    void unmap() {
+        if (map) ::munmap(const_cast<char*>(map), map_size);
+        map = nullptr;
+        map_size = 0;
+    }
+
+    std::mutex mutex; // index, mapa e `end` (leitores de load())
+    std::string path;
+    std::size_t max_bytes;
+    int fd{-1};
+    const char* map{nullptr};
+    std::size_t map_size{0};
+    std::size_t end{0};
+    std::size_t live_bytes{0};
+    std::unordered_map<std::string, Location> index;
+
+    std::mutex queue_mutex;
+    std::condition_variable queued;
+    std::condition_variable drained;
+    std::deque<Job> jobs;
+    std::optional<Job> in_flight; // retirada da fila, ainda sendo gravada
+    std::size_t queued_bytes{0};
+    bool stopping{false};
+    std::thread writer;
+};
+
+#else
+
+// Sem camada em disco no Windows por enquanto: o cache fica só em memória
+class HttpCache::DiskTier {
+public:
+    DiskTier(std::string, std::size_t) {}
+    bool ok() const { return false; }
+    std::shared_ptr<const CacheEntry> load(const std::string&, bool) { return nullptr; }
+    void store(const std::string&, std::shared_ptr<const CacheEntry>) {}
+    void remove(const std::string&) {}
+    void flush() {}
+};
+
+#endif
+
+// --- HttpCache ---
+
+HttpCache::HttpCache(const CacheOptions& options, ResponseLayout layout)
+    : options(options), flat_headers(layout == ResponseLayout::Flat) {
+    const std::size_t count = std::max<std::size_t>(options.shards, 1);
+    shard_budget = options.max_bytes / count;
+    shards.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) shards.push_back(std::make_unique<Shard>());
+
+    if (!options.disk_path.empty()) {
+        disk = std::make_unique<DiskTier>(options.disk_path, options.max_disk_bytes);
+        if (!disk->ok()) disk.reset();
+    }
+}
+
+HttpCache::~HttpCache() = default;
+
+HttpCache::Shard& HttpCache::shard_for(std::string_view key) {
+    return *shards[std::hash<std::string_view>{}(key) % shards.size()];
+}
+
+std::shared_ptr<const CacheEntry> HttpCache::find(const std::string& key) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) return nullptr;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return it->second->second;
+}
+
+void HttpCache::insert(const std::string& key, std::shared_ptr<const CacheEntry> entry) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        shard.bytes -= it->second->second->bytes;
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+    // Maior que o shard inteiro: não vale expulsar todo o resto
+    if (entry->bytes > shard_budget) return;
+
+    shard.bytes += entry->bytes;
+    shard.lru.emplace_front(key, std::move(entry));
+    shard.index.emplace(shard.lru.front().first, shard.lru.begin());
+
+    while (shard.bytes > shard_budget && !shard.lru.empty()) {
+        auto& victim = shard.lru.back();
+        shard.bytes -= victim.second->bytes;
+        shard.index.erase(victim.first);
+        shard.lru.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void HttpCache::erase(const std::string& key) {
+    {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->second->bytes;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+    if (disk) disk->remove(key);
+}
+
+bool HttpCache::lookup(Request& req, Response& out, CacheTicket& ticket) {
+    // Só GET completo em memória; condicionais/Range do próprio chamador passam direto
+    if (req.method != Method::GET || req.sink || has_header(req, "If-None-Match") ||
+        has_header(req, "If-Modified-Since") || has_header(req, "Range")) {
+        return false;
+    }
+
+    bool force_revalidate = false;
+    for (const auto& kv : req.headers) {
+        if (!iequals(kv.first, "Cache-Control")) continue;
+        const CacheControl cc = parse_cache_control(kv.second);
+        if (cc.no_store) return false;
+        force_revalidate = cc.no_cache || (cc.has_max_age && cc.max_age == 0);
+    }
+
+    // A chave inclui os headers da requisição (Authorization, Accept...), o
+    // que também cobre qualquer Vary do servidor
+    ticket.key = req.url;
+    for (const auto& kv : req.headers) {
+        ticket.key.append("\n").append(kv.first).append(": ").append(kv.second);
+    }
+
+    std::shared_ptr<const CacheEntry> entry = find(ticket.key);
+    if (!entry && disk) {
+        if (auto loaded = disk->load(ticket.key, flat_headers)) {
+            disk_hits.fetch_add(1, std::memory_order_relaxed);
+            entry = loaded;
+            insert(ticket.key, std::move(loaded));
+        }
+    }
+    if (!entry) return false;
+
+    if (!force_revalidate && entry->expires_at > now_seconds()) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        out = *entry->response;
+        out.elapsed_time = 0.0; // servido localmente
+        out.timings = Timings{};
+        out.wire_bytes = 0;
+        out.decoded_bytes = out.body.size();
+        ticket.key.clear();
+        return true;
+    }
+
+    if (!entry->etag.empty()) req.headers["If-None-Match"] = entry->etag;
+    if (!entry->last_modified.empty()) req.headers["If-Modified-Since"] = entry->last_modified;
+    if (!entry->etag.empty() || !entry->last_modified.empty()) ticket.stale = std::move(entry);
+    return false;
+}
+
+void HttpCache::complete(CacheTicket& ticket, Response& res) {
+    if (ticket.key.empty()) return;
+    const std::int64_t now = now_seconds();
+
+    if (res.status_code == 304 && res.error_message.empty() && ticket.stale) {
+        revalidations.fetch_add(1, std::memory_order_relaxed);
+
+        // Renova a validade sem copiar o corpo; o disco mantém o prazo antigo
+        // (após reiniciar custa no máximo mais uma revalidação)
+        const Freshness f = freshness_of(res, ticket.stale->response.get(), now);
+        if (f.storable) {
+            insert(ticket.key, make_entry(ticket.stale->response, f.expires_at, ticket.key.size()));
+        }
+
+        const double elapsed = res.elapsed_time;
+        const Timings timings = res.timings;
+        const std::uint64_t wire_bytes = res.wire_bytes;
+        res = *ticket.stale->response;
+        res.elapsed_time = elapsed;
+        res.timings = timings;
+        res.wire_bytes = wire_bytes;
+        return;
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    if (res.status_code != 200 || !res.error_message.empty()) return;
+
+    const Freshness f = freshness_of(res, nullptr, now);
+    if (!f.storable) {
+        erase(ticket.key);
+        return;
+    }
+
+    auto entry = make_entry(std::make_shared<const Response>(res), f.expires_at, ticket.key.size());
+    stores.fetch_add(1, std::memory_order_relaxed);
+    if (disk) disk->store(ticket.key, entry);
+    insert(ticket.key, std::move(entry));
+}
+
+void HttpCache::flush() {
+    if (disk) disk->flush();
+}
+
+CacheStats HttpCache::stats() const {
+    CacheStats s;
+    s.hits = hits.load(std::memory_order_relaxed);
+    s.misses = misses.load(std::memory_order_relaxed);
+    s.revalidations = revalidations.load(std::memory_order_relaxed);
+    s.disk_hits = disk_hits.load(std::memory_order_relaxed);
+    s.stores = stores.load(std::memory_order_relaxed);
+    s.evictions = evictions.load(std::memory_order_relaxed);
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        s.bytes += shard->bytes;
+        s.entries += shard->lru.size();
+    }
+    return s;
+}
+
+} // namespace locosync::detail
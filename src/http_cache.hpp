@@ -0,0 +1,91 @@
+#ifndef LOCOSYNC_HTTP_CACHE_HPP
+#define LOCOSYNC_HTTP_CACHE_HPP
+
+#include "locosync/options.hpp"
+#include "locosync/request.hpp"
+#include "locosync/response.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace locosync::detail {
+
+// Resposta armazenada; imutável depois de criada (compartilhada entre leitores)
+struct CacheEntry {
+    std::shared_ptr<const Response> response;
+    std::string etag;
+    std::string last_modified;
+    std::int64_t expires_at{0}; // epoch em segundos; vencida = precisa revalidar
+    std::size_t bytes{0};
+};
+
+// Estado do cache para uma requisição em andamento
+struct CacheTicket {
+    std::string key;                          // vazio = requisição fora do cache
+    std::shared_ptr<const CacheEntry> stale;  // entrada sendo revalidada
+};
+
+// Cache HTTP privado: LRU em memória dividido em shards (um mutex cada) e
+// camada opcional em disco, append-only e mapeada em memória.
+class HttpCache {
+public:
+    HttpCache(const CacheOptions& options, ResponseLayout layout);
+    ~HttpCache();
+
+    HttpCache(const HttpCache&) = delete;
+    HttpCache& operator=(const HttpCache&) = delete;
+
+    // Antes do envio. Retorna true quando há cópia fresca (já em `out`).
+    // Com uma cópia vencida, adiciona If-None-Match / If-Modified-Since em `req`.
+    bool lookup(Request& req, Response& out, CacheTicket& ticket);
+
+    // Depois da resposta: um 304 é trocado pela cópia armazenada e uma
+    // resposta 200 cacheável é guardada.
+    void complete(CacheTicket& ticket, Response& res);
+
+    // Espera as gravações pendentes na camada em disco (feitas em outra thread)
+    void flush();
+
+    CacheStats stats() const;
+
+private:
+    class DiskTier;
+
+    using LruList = std::list<std::pair<std::string, std::shared_ptr<const CacheEntry>>>;
+
+    struct Shard {
+        std::mutex mutex;
+        LruList lru; // mais recente na frente
+        std::unordered_map<std::string_view, LruList::iterator> index; // chaves apontam para lru
+        std::size_t bytes{0};
+    };
+
+    Shard& shard_for(std::string_view key);
+    std::shared_ptr<const CacheEntry> find(const std::string& key);
+    void insert(const std::string& key, std::shared_ptr<const CacheEntry> entry);
+    void erase(const std::string& key);
+
+    CacheOptions options;
+    bool flat_headers{false};
+    std::size_t shard_budget{0};
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::unique_ptr<DiskTier> disk;
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> revalidations{0};
+    std::atomic<std::uint64_t> disk_hits{0};
+    std::atomic<std::uint64_t> stores{0};
+    std::atomic<std::uint64_t> evictions{0};
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_HTTP_CACHE_HPP
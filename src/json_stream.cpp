@@ -0,0 +1,572 @@
+#include "locosync/json_stream.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace locosync {
+
+using json = nlohmann::json;
+
+// --- JsonPushParser ---
+
+JsonPushParser::JsonPushParser(Sax& handler) : sax(handler) {}
+
+static bool is_ws(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool is_number_char(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+// Gramática de número JSON: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+static bool valid_number(const std::string& s, bool& is_float) {
+    std::size_t i = 0;
+    const std::size_t n = s.size();
+    auto digits = [&] {
+        const std::size_t start = i;
+        while (i < n && s[i] >= '0' && s[i] <= '9') ++i;
+        return i > start;
+    };
+
+    is_float = false;
+    if (i < n && s[i] == '-') ++i;
+    if (i < n && s[i] == '0') {
+        ++i;
+    } else if (!digits()) {
+        return false;
+    }
+    if (i < n && s[i] == '.') {
+        ++i;
+        is_float = true;
+        if (!digits()) return false;
+    }
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        is_float = true;
+        if (i < n && (s[i] == '+' || s[i] == '-')) ++i;
+        if (!digits()) return false;
+    }
+    return i == n;
+}
+
+bool JsonPushParser::fail(const std::string& message) {
+    if (error_message.empty()) {
+        error_message = message;
+        auto ex = json::parse_error::create(101, position, message, nullptr);
+        sax.parse_error(position, buffer, ex);
+    }
+    expect = Expect::Done;
+    return false;
+}
+
+bool JsonPushParser::check(bool handler_result) {
+    if (!handler_result && error_message.empty()) error_message = "JSON parsing stopped by handler";
+    return handler_result;
+}
+
+bool JsonPushParser::after_value() {
+    expect = stack.empty() ? Expect::Done : Expect::CommaOrEnd;
+    return true;
+}
+
+bool JsonPushParser::append_code_point(std::uint32_t cp) {
+    // UTF-8
+    if (cp < 0x80) {
+        buffer.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        buffer.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        buffer.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        buffer.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        buffer.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        buffer.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        buffer.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        buffer.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        buffer.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        buffer.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    return true;
+}
+
+// Valida um byte do texto (sem escape) pela tabela da RFC 3629: rejeita
+// sequências truncadas, formas longas e surrogates, como o nlohmann
+bool JsonPushParser::utf8_byte(unsigned char b) {
+    if (utf8_left == 0) {
+        if (b < 0x80) return true;
+        utf8_low = 0x80;
+        utf8_high = 0xBF;
+        if (b >= 0xC2 && b <= 0xDF) {
+            utf8_left = 1;
+        } else if (b == 0xE0) {
+            utf8_left = 2;
+            utf8_low = 0xA0;
+        } else if ((b >= 0xE1 && b <= 0xEC) || b == 0xEE || b == 0xEF) {
+            utf8_left = 2;
+        } else if (b == 0xED) {
+            utf8_left = 2;
+            utf8_high = 0x9F;
+        } else if (b == 0xF0) {
+            utf8_left = 3;
+            utf8_low = 0x90;
+        } else if (b >= 0xF1 && b <= 0xF3) {
+            utf8_left = 3;
+        } else if (b == 0xF4) {
+            utf8_left = 3;
+            utf8_high = 0x8F;
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (b < utf8_low || b > utf8_high) return false;
+    --utf8_left;
+    utf8_low = 0x80;
+    utf8_high = 0xBF;
+    return true;
+}
+
+bool JsonPushParser::end_string() {
+    token = Token::None;
+    if (high_surrogate) return fail("invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF");
+
+    bool ok;
+    if (string_is_key) {
+        ok = check(sax.key(buffer));
+        expect = Expect::Colon;
+    } else {
+        ok = check(sax.string(buffer));
+        after_value();
+    }
+    buffer.clear();
+    return ok;
+}
+
+bool JsonPushParser::end_number() {
+    token = Token::None;
+    bool is_float = false;
+    if (!valid_number(buffer, is_float)) return fail("invalid number: '" + buffer + "'");
+
+    // from_chars ignora o locale (strtod seguiria LC_NUMERIC: "1.25" viraria 1 em pt_BR)
+    const char* first = buffer.data();
+    const char* last = first + buffer.size();
+    bool ok = true;
+    if (!is_float) {
+        std::from_chars_result r;
+        if (buffer[0] == '-') {
+            json::number_integer_t v = 0;
+            r = std::from_chars(first, last, v);
+            if (r.ec == std::errc{}) ok = check(sax.number_integer(v));
+        } else {
+            json::number_unsigned_t v = 0;
+            r = std::from_chars(first, last, v);
+            if (r.ec == std::errc{}) ok = check(sax.number_unsigned(v));
+        }
+        // Inteiro fora da faixa de 64 bits segue como ponto flutuante
+        is_float = r.ec != std::errc{};
+    }
+    if (is_float) {
+        json::number_float_t v = 0.0;
+        const auto r = std::from_chars(first, last, v);
+        if (r.ec == std::errc::result_out_of_range) {
+            // Underflow vira zero; overflow é erro, como no nlohmann::json::parse
+            const auto e = buffer.find_first_of("eE");
+            if (e == std::string::npos || buffer[e + 1] != '-') return fail("number overflow parsing '" + buffer + "'");
+            v = buffer[0] == '-' ? -0.0 : 0.0;
+        } else if (r.ec != std::errc{}) {
+            return fail("invalid number: '" + buffer + "'");
+        }
+        ok = check(sax.number_float(v, buffer));
+    }
+
+    buffer.clear();
+    after_value();
+    return ok;
+}
+
+bool JsonPushParser::end_literal() {
+    token = Token::None;
+    bool ok;
+    if (buffer == "true") ok = check(sax.boolean(true));
+    else if (buffer == "false") ok = check(sax.boolean(false));
+    else if (buffer == "null") ok = check(sax.null());
+    else return fail("invalid literal: '" + buffer + "'");
+
+    buffer.clear();
+    after_value();
+    return ok;
+}
+
+bool JsonPushParser::string_char(const char* data, std::size_t size, std::size_t& i) {
+    const char c = data[i];
+
+    if (escape == 0) {
+        if ((c == '"' || c == '\\') && utf8_left) return fail("invalid string: ill-formed UTF-8 byte");
+        if (c == '"') return end_string();
+        if (c == '\\') {
+            escape = 1;
+            return true;
+        }
+        if (high_surrogate) return fail("invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF");
+        if (static_cast<unsigned char>(c) < 0x20) return fail("invalid string: control character must be escaped");
+
+        // Caminho rápido: copia o trecho até a próxima aspa ou barra de uma vez.
+        // Bytes ASCII fora de uma sequência multibyte dispensam a validação.
+        std::size_t end = i;
+        while (end < size) {
+            const auto b = static_cast<unsigned char>(data[end]);
+            if (b == '"' || b == '\\' || b < 0x20) break;
+            if ((b >= 0x80 || utf8_left) && !utf8_byte(b)) {
+                position += end - i;
+                return fail("invalid string: ill-formed UTF-8 byte");
+            }
+            ++end;
+        }
+        buffer.append(data + i, end - i);
+        position += end - i - 1;
+        i = end - 1;
+        return true;
+    }
+
+    if (escape == 1) {
+        if (c != 'u' && high_surrogate) return fail("invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF");
+        escape = 0;
+        switch (c) {
+            case '"':  buffer.push_back('"'); return true;
+            case '\\': buffer.push_back('\\'); return true;
+            case '/':  buffer.push_back('/'); return true;
+            case 'b':  buffer.push_back('\b'); return true;
+            case 'f':  buffer.push_back('\f'); return true;
+            case 'n':  buffer.push_back('\n'); return true;
+            case 'r':  buffer.push_back('\r'); return true;
+            case 't':  buffer.push_back('\t'); return true;
+            case 'u':  escape = 2; hex = 0; return true;
+            default:   return fail("invalid string: forbidden character after backslash");
+        }
+    }
+
+    // \uXXXX
+    std::uint32_t digit;
+    if (c >= '0' && c <= '9') digit = static_cast<std::uint32_t>(c - '0');
+    else if (c >= 'a' && c <= 'f') digit = static_cast<std::uint32_t>(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F') digit = static_cast<std::uint32_t>(c - 'A' + 10);
+    else return fail("invalid string: '\\u' must be followed by 4 hex digits");
+
+    hex = (hex << 4) | digit;
+    if (++escape < 6) return true;
+    escape = 0;
+
+    if (high_surrogate) {
+        if (hex < 0xDC00 || hex > 0xDFFF) return fail("invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF");
+        const std::uint32_t cp = 0x10000 + ((high_surrogate - 0xD800) << 10) + (hex - 0xDC00);
+        high_surrogate = 0;
+        return append_code_point(cp);
+    }
+    if (hex >= 0xD800 && hex <= 0xDBFF) {
+        high_surrogate = hex;
+        return true;
+    }
+    if (hex >= 0xDC00 && hex <= 0xDFFF) return fail("invalid string: surrogate U+DC00..U+DFFF must follow U+D800..U+DBFF");
+    return append_code_point(hex);
+}
+
+bool JsonPushParser::structural(char c) {
+    if (is_ws(c)) return true;
+
+    switch (expect) {
+        case Expect::FirstValueOrEnd:
+            if (c == ']') {
+                stack.pop_back();
+                if (!check(sax.end_array())) return false;
+                return after_value();
+            }
+            [[fallthrough]];
+        case Expect::Value:
+            switch (c) {
+                case '{':
+                    stack.push_back('{');
+                    expect = Expect::FirstKeyOrEnd;
+                    return check(sax.start_object(static_cast<std::size_t>(-1)));
+                case '[':
+                    stack.push_back('[');
+                    expect = Expect::FirstValueOrEnd;
+                    return check(sax.start_array(static_cast<std::size_t>(-1)));
+                case '"':
+                    token = Token::String;
+                    string_is_key = false;
+                    return true;
+                case 't': case 'f': case 'n':
+                    token = Token::Literal;
+                    buffer.push_back(c);
+                    return true;
+                default:
+                    if (c == '-' || (c >= '0' && c <= '9')) {
+                        token = Token::Number;
+                        buffer.push_back(c);
+                        return true;
+                    }
+                    return fail(std::string("syntax error: unexpected '") + c + "'");
+            }
+
+        case Expect::FirstKeyOrEnd:
+            if (c == '}') {
+                stack.pop_back();
+                if (!check(sax.end_object())) return false;
+                return after_value();
+            }
+            [[fallthrough]];
+        case Expect::Key:
+            if (c != '"') return fail("syntax error: expected object key");
+            token = Token::String;
+            string_is_key = true;
+            return true;
+
+        case Expect::Colon:
+            if (c != ':') return fail("syntax error: expected ':'");
+            expect = Expect::Value;
+            return true;
+
+        case Expect::CommaOrEnd:
+            if (c == ',') {
+                expect = stack.back() == '{' ? Expect::Key : Expect::Value;
+                return true;
+            }
+            if (c == '}' && stack.back() == '{') {
+                stack.pop_back();
+                if (!check(sax.end_object())) return false;
+                return after_value();
+            }
+            if (c == ']' && stack.back() == '[') {
+                stack.pop_back();
+                if (!check(sax.end_array())) return false;
+                return after_value();
+            }
+            return fail(std::string("syntax error: unexpected '") + c + "'");
+
+        case Expect::Done:
+            return fail("syntax error: unexpected data after the JSON document");
+    }
+    return false;
+}
+
+bool JsonPushParser::feed(const char* data, std::size_t size) {
+    if (!error_message.empty()) return false;
+
+    for (std::size_t i = 0; i < size; ++i, ++position) {
+        const char c = data[i];
+
+        switch (token) {
+            case Token::String:
+                if (!string_char(data, size, i)) return false;
+                continue;
+            case Token::Number:
+                if (is_number_char(c)) {
+                    buffer.push_back(c);
+                    continue;
+                }
+                if (!end_number()) return false;
+                break;
+            case Token::Literal:
+                if (c >= 'a' && c <= 'z') {
+                    buffer.push_back(c);
+                    continue;
+                }
+                if (!end_literal()) return false;
+                break;
+            case Token::None:
+                break;
+        }
+
+        if (!structural(c)) return false;
+    }
+    return true;
+}
+
+bool JsonPushParser::finish() {
+    if (!error_message.empty()) return false;
+
+    // Número ou literal na raiz só termina no fim da entrada
+    if (token == Token::Number && !end_number()) return false;
+    if (token == Token::Literal && !end_literal()) return false;
+
+    if (token != Token::None || expect != Expect::Done) {
+        return fail("syntax error: unexpected end of input");
+    }
+    return true;
+}
+
+// --- Sinks ---
+
+namespace {
+
+class JsonSaxSink : public BodySink {
+public:
+    explicit JsonSaxSink(JsonPushParser::Sax& handler) : parser(handler) {}
+
+    bool write(const char* data, std::size_t size) override { return parser.feed(data, size); }
+    void finish(bool ok) override {
+        if (ok) parser.finish();
+    }
+    std::string error() const override { return parser.error(); }
+
+private:
+    JsonPushParser parser;
+};
+
+// Handler SAX que materializa apenas um elemento do array alvo por vez
+class ArrayElementSax : public JsonPushParser::Sax {
+public:
+    ArrayElementSax(std::vector<std::string> target, std::function<bool(json&&)> on_element)
+        : target(std::move(target)), on_element(std::move(on_element)) {}
+
+    bool null() override { return value(json(nullptr)); }
+    bool boolean(bool v) override { return value(json(v)); }
+    bool number_integer(number_integer_t v) override { return value(json(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return value(json(v)); }
+    bool number_float(number_float_t v, const string_t&) override { return value(json(v)); }
+    bool string(string_t& v) override { return value(json(std::move(v))); }
+    bool binary(binary_t& v) override { return value(json::binary(std::move(v))); }
+
+    bool start_object(std::size_t) override { return open(json::object(), false); }
+    bool start_array(std::size_t) override { return open(json::array(), true); }
+
+    bool key(string_t& k) override {
+        if (!building.empty()) {
+            pending_key = std::move(k);
+        } else {
+            frames.back().key = std::move(k);
+        }
+        return true;
+    }
+
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    struct Frame {
+        bool is_array;
+        bool is_target;
+        std::string key; // última chave vista (objetos)
+    };
+
+    // Caminho atual (apenas objetos) coincide com o alvo?
+    bool at_target() const {
+        if (frames.size() != target.size()) return false;
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            if (frames[i].is_array || frames[i].key != target[i]) return false;
+        }
+        return true;
+    }
+
+    bool inside_target() const { return !frames.empty() && frames.back().is_target; }
+
+    bool value(json&& v) {
+        if (!building.empty()) {
+            attach(std::move(v));
+            return true;
+        }
+        if (inside_target()) return on_element(std::move(v));
+        return true;
+    }
+
+    void attach(json&& v) {
+        json& top = *building.back();
+        if (top.is_object()) top[pending_key] = std::move(v);
+        else top.push_back(std::move(v));
+    }
+
+    bool open(json&& container, bool is_array) {
+        if (!building.empty()) {
+            json& top = *building.back();
+            json* child;
+            if (top.is_object()) {
+                child = &(top[pending_key] = std::move(container));
+            } else {
+                top.push_back(std::move(container));
+                child = &top.back();
+            }
+            building.push_back(child);
+            return true;
+        }
+        if (inside_target()) {
+            element = std::move(container);
+            building.push_back(&element);
+            return true;
+        }
+        // O array aberto agora é o alvo se o caminho até ele coincidir
+        frames.push_back({is_array, is_array && at_target(), {}});
+        return true;
+    }
+
+    bool close() {
+        if (!building.empty()) {
+            building.pop_back();
+            if (building.empty()) return on_element(std::move(element));
+            return true;
+        }
+        if (!frames.empty()) frames.pop_back();
+        return true;
+    }
+
+    std::vector<std::string> target;
+    std::function<bool(json&&)> on_element;
+
+    std::vector<Frame> frames;
+    std::vector<json*> building;
+    json element;
+    std::string pending_key;
+};
+
+class JsonArraySink : public BodySink {
+public:
+    JsonArraySink(std::vector<std::string> target, std::function<bool(json&&)> on_element)
+        : handler(std::move(target), std::move(on_element)), parser(handler) {}
+
+    bool write(const char* data, std::size_t size) override { return parser.feed(data, size); }
+    void finish(bool ok) override {
+        if (ok) parser.finish();
+    }
+    std::string error() const override { return parser.error(); }
+
+private:
+    ArrayElementSax handler;
+    JsonPushParser parser;
+};
+
+// "/a/b~1c" -> {"a", "b/c"}
+std::vector<std::string> split_pointer(const std::string& pointer) {
+    std::vector<std::string> tokens;
+    if (pointer.empty()) return tokens;
+
+    std::size_t start = pointer[0] == '/' ? 1 : 0;
+    while (start <= pointer.size()) {
+        std::size_t end = pointer.find('/', start);
+        if (end == std::string::npos) end = pointer.size();
+        std::string token = pointer.substr(start, end - start);
+        for (std::size_t p = 0; (p = token.find('~', p)) != std::string::npos; ++p) {
+            if (p + 1 < token.size() && token[p + 1] == '1') token.replace(p, 2, "/");
+            else if (p + 1 < token.size() && token[p + 1] == '0') token.replace(p, 2, "~");
+        }
+        tokens.push_back(std::move(token));
+        start = end + 1;
+    }
+    return tokens;
+}
+
+} // namespace
+
+std::shared_ptr<BodySink> json_sax_sink(nlohmann::json_sax<nlohmann::json>& handler) {
+    return std::make_shared<JsonSaxSink>(handler);
+}
+
+std::shared_ptr<BodySink> json_array_sink(std::string pointer, std::function<bool(json&&)> on_element) {
+    return std::make_shared<JsonArraySink>(split_pointer(pointer), std::move(on_element));
+}
+
+} // namespace locosync
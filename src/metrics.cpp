@@ -0,0 +1,182 @@
+#include "metrics.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace locosync::detail {
+
+namespace {
+
+std::uint64_t to_micros(double seconds) {
+    return seconds > 0.0 ? static_cast<std::uint64_t>(seconds * 1e6) : 0;
+}
+
+void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+    if (value) counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+// Valor de label com escapes do formato texto (\, " e quebra de linha)
+std::string label(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') out.push_back('\\');
+        if (c == '\n') {
+            out.append("\\n");
+            continue;
+        }
+        out.push_back(c);
+    }
+    return out;
+}
+
+std::string seconds_text(std::uint64_t micros) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(micros) / 1e6);
+    return buffer;
+}
+
+} // namespace
+
+// --- LatencyHistogram ---
+
+std::size_t LatencyHistogram::bucket_of(std::uint64_t micros) {
+    // Valores pequenos são exatos; depois, 4 sub-buckets por potência de 2
+    if (micros < kSubBuckets) return static_cast<std::size_t>(micros);
+    const std::size_t exponent = static_cast<std::size_t>(std::bit_width(micros)) - 1;
+    if (exponent >= kMaxExponent) return kBuckets - 1;
+    const std::size_t sub = static_cast<std::size_t>(micros >> (exponent - 2)) & (kSubBuckets - 1);
+    return kSubBuckets * (exponent - 1) + sub;
+}
+
+std::uint64_t LatencyHistogram::upper_bound(std::size_t bucket) {
+    if (bucket < kSubBuckets) return bucket;
+    const std::size_t exponent = bucket / kSubBuckets + 1;
+    const std::uint64_t sub = bucket % kSubBuckets;
+    return ((kSubBuckets + sub + 1) << (exponent - 2)) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t micros) {
+    counts[bucket_of(micros)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+}
+
+// --- MetricsRegistry ---
+
+MetricsRegistry::~MetricsRegistry() {
+    for (auto& slot : slots) delete slot.load(std::memory_order_acquire);
+}
+
+HostMetrics& MetricsRegistry::host(const std::string& origin) {
+    const std::size_t hash = std::hash<std::string>{}(origin);
+    for (std::size_t probe = 0; probe < kCapacity; ++probe) {
+        auto& slot = slots[(hash + probe) & (kCapacity - 1)];
+        HostMetrics* current = slot.load(std::memory_order_acquire);
+        if (!current) {
+            auto* fresh = new HostMetrics(origin);
+            if (slot.compare_exchange_strong(current, fresh, std::memory_order_acq_rel)) return *fresh;
+            // Outra thread ocupou o slot primeiro; `current` agora aponta para o dela
+            delete fresh;
+        }
+        if (current->origin == origin) return *current;
+    }
+    return overflow;
+}
+
+void MetricsRegistry::record(const std::string& origin, const Response& res) {
+    HostMetrics& m = host(origin);
+
+    m.requests.fetch_add(1, std::memory_order_relaxed);
+    if (res.status_code >= 100 && res.status_code < 600) {
+        m.status[static_cast<std::size_t>(res.status_code / 100 - 1)].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    add(m.received_bytes, res.wire_bytes);
+
+    const Timings& t = res.timings;
+    add(m.queue_us, to_micros(t.queue));
+    add(m.dns_us, to_micros(t.dns));
+    add(m.connect_us, to_micros(t.connect));
+    add(m.tls_us, to_micros(t.tls));
+    add(m.ttfb_us, to_micros(t.ttfb));
+    add(m.transfer_us, to_micros(t.transfer));
+    m.latency.record(to_micros(t.queue + t.total));
+}
+
+std::string MetricsRegistry::prometheus() const {
+    std::vector<const HostMetrics*> hosts;
+    for (const auto& slot : slots) {
+        if (const HostMetrics* m = slot.load(std::memory_order_acquire)) hosts.push_back(m);
+    }
+    if (overflow.requests.load(std::memory_order_relaxed) > 0) hosts.push_back(&overflow);
+
+    std::string out;
+    auto header = [&](const char* name, const char* type, const char* help) {
+        out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+    };
+    auto sample = [&](const char* name, const std::string& labels, const std::string& value) {
+        out.append(name).append("{").append(labels).append("} ").append(value).append("\n");
+    };
+
+    header("locosync_requests_total", "counter", "Transfers completed, per host.");
+    for (const auto* m : hosts) {
+        sample("locosync_requests_total", "host=\"" + label(m->origin) + "\"", std::to_string(m->requests.load()));
+    }
+
+    header("locosync_responses_total", "counter", "HTTP responses by status class.");
+    for (const auto* m : hosts) {
+        for (std::size_t i = 0; i < m->status.size(); ++i) {
+            sample("locosync_responses_total",
+                   "host=\"" + label(m->origin) + "\",class=\"" + std::to_string(i + 1) + "xx\"",
+                   std::to_string(m->status[i].load()));
+        }
+    }
+
+    header("locosync_transport_errors_total", "counter", "Transfers that failed without an HTTP status.");
+    for (const auto* m : hosts) {
+        sample("locosync_transport_errors_total", "host=\"" + label(m->origin) + "\"", std::to_string(m->errors.load()));
+    }
+
+    header("locosync_received_bytes_total", "counter", "Response body bytes received on the wire.");
+    for (const auto* m : hosts) {
+        sample("locosync_received_bytes_total", "host=\"" + label(m->origin) + "\"",
+               std::to_string(m->received_bytes.load()));
+    }
+
+    header("locosync_phase_seconds_total", "counter", "Time spent in each request phase.");
+    for (const auto* m : hosts) {
+        const std::string host = "host=\"" + label(m->origin) + "\",phase=\"";
+        sample("locosync_phase_seconds_total", host + "queue\"", seconds_text(m->queue_us.load()));
+        sample("locosync_phase_seconds_total", host + "dns\"", seconds_text(m->dns_us.load()));
+        sample("locosync_phase_seconds_total", host + "connect\"", seconds_text(m->connect_us.load()));
+        sample("locosync_phase_seconds_total", host + "tls\"", seconds_text(m->tls_us.load()));
+        sample("locosync_phase_seconds_total", host + "ttfb\"", seconds_text(m->ttfb_us.load()));
+        sample("locosync_phase_seconds_total", host + "transfer\"", seconds_text(m->transfer_us.load()));
+    }
+
+    header("locosync_request_duration_seconds", "histogram", "Request latency (queue + transfer).");
+    for (const auto* m : hosts) {
+        const std::string host = "host=\"" + label(m->origin) + "\"";
+        // Leitura não atômica do conjunto: contagem acumulada consistente com os buckets lidos
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b < LatencyHistogram::kBuckets; ++b) {
+            cumulative += m->latency.count_at(b);
+            sample("locosync_request_duration_seconds_bucket",
+                   host + ",le=\"" + seconds_text(LatencyHistogram::upper_bound(b)) + "\"",
+                   std::to_string(cumulative));
+        }
+        sample("locosync_request_duration_seconds_bucket", host + ",le=\"+Inf\"", std::to_string(cumulative));
+        sample("locosync_request_duration_seconds_sum", host, seconds_text(m->latency.sum_micros()));
+        sample("locosync_request_duration_seconds_count", host, std::to_string(cumulative));
+    }
+
+    return out;
+}
+
+} // namespace locosync::detail
@@ -0,0 +1,89 @@
+#ifndef LOCOSYNC_METRICS_HPP
+#define LOCOSYNC_METRICS_HPP
+
+#include "locosync/response.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace locosync::detail {
+
+// Histograma de latência no estilo HDR: buckets logarítmicos (4 sub-buckets
+// por potência de 2, em microssegundos), erro relativo <= 25%. Só contadores
+// atômicos: gravar e ler nunca bloqueiam.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kSubBuckets = 4;
+    static constexpr std::size_t kMaxExponent = 34; // ~4,7 horas
+    static constexpr std::size_t kBuckets = kSubBuckets * (kMaxExponent - 1);
+
+    void record(std::uint64_t micros);
+
+    std::uint64_t count_at(std::size_t bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t sum_micros() const { return sum.load(std::memory_order_relaxed); }
+
+    static std::size_t bucket_of(std::uint64_t micros);
+    // Maior valor (inclusive, em microssegundos) que cai no bucket
+    static std::uint64_t upper_bound(std::size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> counts{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sum{0};
+};
+
+// Contadores de um host (origem scheme://host:port)
+struct HostMetrics {
+    explicit HostMetrics(std::string origin) : origin(std::move(origin)) {}
+
+    const std::string origin;
+
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> errors{0};                // falha de transporte (sem status HTTP)
+    std::array<std::atomic<std::uint64_t>, 5> status{}; // 1xx..5xx
+    std::atomic<std::uint64_t> received_bytes{0}; // Response::wire_bytes
+
+    // Soma do tempo por fase, em microssegundos
+    std::atomic<std::uint64_t> queue_us{0};
+    std::atomic<std::uint64_t> dns_us{0};
+    std::atomic<std::uint64_t> connect_us{0};
+    std::atomic<std::uint64_t> tls_us{0};
+    std::atomic<std::uint64_t> ttfb_us{0};
+    std::atomic<std::uint64_t> transfer_us{0};
+
+    LatencyHistogram latency;
+};
+
+// Registro de métricas do Client. Tabela de endereçamento aberto de tamanho
+// fixo com ponteiros atômicos: um host novo entra via compare_exchange e
+// nunca sai, então leitores percorrem a tabela sem lock. Hosts além da
+// capacidade são somados em "other".
+class MetricsRegistry {
+public:
+    MetricsRegistry() = default;
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    void record(const std::string& origin, const Response& res);
+
+    // Snapshot no formato texto do Prometheus (exposition format 0.0.4)
+    std::string prometheus() const;
+
+private:
+    static constexpr std::size_t kCapacity = 256; // potência de 2
+
+    HostMetrics& host(const std::string& origin);
+
+    std::array<std::atomic<HostMetrics*>, kCapacity> slots{};
+    HostMetrics overflow{"other"};
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_METRICS_HPP
@@ -0,0 +1,253 @@
+#include "reactor.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace locosync::detail {
+
+// Entrega o resultado ao dono da Transfer; exceções do callback não podem
+// escapar para dentro do loop de eventos.
+static void finish_transfer(Transfer& t) {
+    if (!t.on_done) return;
+    try {
+        t.on_done(t);
+    } catch (...) {
+    }
+}
+
+// --- Reactor ---
+
+Reactor::Reactor(std::size_t threads, const PoolOptions& pool_options) {
+    threads = std::max<std::size_t>(threads, 1);
+    loops.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        loops.push_back(std::make_unique<Loop>(pool_options));
+    }
+}
+
+Reactor::~Reactor() = default;
+
+void Reactor::submit(TransferPtr transfer) {
+    // Round-robin entre os loops
+    const std::size_t index = next_loop.fetch_add(1, std::memory_order_relaxed) % loops.size();
+    loops[index]->submit(std::move(transfer));
+}
+
+// --- Reactor::Loop ---
+
+Reactor::Loop::Loop(const PoolOptions& pool_options) {
+    multi = curl_multi_init();
+
+#ifdef __linux__
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, &Loop::on_socket);
+    curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, &Loop::on_timer);
+    curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+#endif
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    if (pool_options.max_connections_per_host > 0) {
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                          static_cast<long>(pool_options.max_connections_per_host));
+    }
+
+#ifdef __linux__
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+#endif
+
+    worker = std::thread([this] { run(); });
+}
+
+Reactor::Loop::~Loop() {
+    stopping.store(true, std::memory_order_release);
+    wakeup();
+    if (worker.joinable()) worker.join();
+
+    abort_all("Request cancelled: client destroyed.");
+
+#ifdef __linux__
+    if (wake_fd >= 0) close(wake_fd);
+    if (epoll_fd >= 0) close(epoll_fd);
+#endif
+    if (multi) curl_multi_cleanup(multi);
+}
+
+void Reactor::Loop::submit(TransferPtr transfer) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        submitted.push_back(std::move(transfer));
+    }
+    wakeup();
+}
+
+void Reactor::Loop::wakeup() {
+#ifdef __linux__
+    const uint64_t one = 1;
+    [[maybe_unused]] auto n = write(wake_fd, &one, sizeof(one));
+#else
+    curl_multi_wakeup(multi);
+#endif
+}
+
+void Reactor::Loop::drain_submissions() {
+    // Os dois vetores são trocados e reaproveitados: a capacidade fica entre lotes
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        pending.swap(submitted);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& t : pending) {
+        CURL* easy = t->lease.get();
+        t->started_at = now;
+        CURLMcode mc = curl_multi_add_handle(multi, easy);
+        if (mc != CURLM_OK) {
+            t->response.error_message = curl_multi_strerror(mc);
+            finish_transfer(*t);
+            continue;
+        }
+        t->active_index = active.size();
+        active.push_back(std::move(t));
+    }
+    pending.clear();
+}
+
+void Reactor::Loop::check_completed() {
+    int pending = 0;
+    while (CURLMsg* msg = curl_multi_info_read(multi, &pending)) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        // msg é invalidado por curl_multi_remove_handle: copiar antes
+        CURL* easy = msg->easy_handle;
+        const CURLcode code = msg->data.result;
+        curl_multi_remove_handle(multi, easy);
+
+        // CURLOPT_PRIVATE aponta para a Transfer (ver configure())
+        Transfer* raw = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &raw);
+        if (!raw || raw->active_index >= active.size() || active[raw->active_index].get() != raw) continue;
+
+        const std::size_t index = raw->active_index;
+        TransferPtr t = std::move(active[index]);
+        if (index + 1 != active.size()) {
+            active[index] = std::move(active.back());
+            active[index]->active_index = index;
+        }
+        active.pop_back();
+
+        collect(*t, code);
+        finish_transfer(*t);
+        // t volta à arena aqui: o handle volta ao pool
+    }
+}
+
+void Reactor::Loop::abort_all(const char* reason) {
+    drain_submissions();
+    for (auto& t : active) {
+        curl_multi_remove_handle(multi, t->lease.get());
+        t->response.error_message = reason;
+        finish_transfer(*t);
+    }
+    active.clear();
+}
+
+#ifdef __linux__
+
+int Reactor::Loop::on_timer(CURLM*, long timeout_ms, void* userp) {
+    auto* self = static_cast<Loop*>(userp);
+    if (timeout_ms < 0) {
+        self->timer_armed = false;
+    } else {
+        self->timer_armed = true;
+        self->timer_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    }
+    return 0;
+}
+
+int Reactor::Loop::on_socket(CURL*, curl_socket_t s, int what, void* userp, void*) {
+    auto* self = static_cast<Loop*>(userp);
+
+    if (what == CURL_POLL_REMOVE) {
+        epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, s, nullptr);
+        return 0;
+    }
+
+    epoll_event ev{};
+    ev.data.fd = s;
+    if (what & CURL_POLL_IN) ev.events |= EPOLLIN;
+    if (what & CURL_POLL_OUT) ev.events |= EPOLLOUT;
+
+    if (epoll_ctl(self->epoll_fd, EPOLL_CTL_MOD, s, &ev) != 0 && errno == ENOENT) {
+        epoll_ctl(self->epoll_fd, EPOLL_CTL_ADD, s, &ev);
+    }
+    return 0;
+}
+
+void Reactor::Loop::run() {
+    constexpr int kMaxEvents = 64;
+    epoll_event events[kMaxEvents];
+    int running = 0;
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        int wait_ms = -1;
+        if (timer_armed) {
+            const auto remaining = timer_deadline - std::chrono::steady_clock::now();
+            wait_ms = static_cast<int>(std::max<long long>(
+                0, std::chrono::ceil<std::chrono::milliseconds>(remaining).count()));
+        }
+
+        const int n = epoll_wait(epoll_fd, events, kMaxEvents, wait_ms);
+        if (n < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < n; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd) {
+                uint64_t value = 0;
+                [[maybe_unused]] auto r = read(wake_fd, &value, sizeof(value));
+                drain_submissions();
+                continue;
+            }
+
+            int flags = 0;
+            if (events[i].events & EPOLLIN) flags |= CURL_CSELECT_IN;
+            if (events[i].events & EPOLLOUT) flags |= CURL_CSELECT_OUT;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) flags |= CURL_CSELECT_ERR;
+            curl_multi_socket_action(multi, fd, flags, &running);
+        }
+
+        if (timer_armed && std::chrono::steady_clock::now() >= timer_deadline) {
+            timer_armed = false;
+            curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &running);
+        }
+
+        check_completed();
+    }
+}
+
+#else
+
+// Fallback portátil: curl_multi_poll aguarda sockets ou curl_multi_wakeup()
+void Reactor::Loop::run() {
+    int running = 0;
+    while (!stopping.load(std::memory_order_acquire)) {
+        drain_submissions();
+        curl_multi_perform(multi, &running);
+        check_completed();
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+}
+
+#endif
+
+} // namespace locosync::detail
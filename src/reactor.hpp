@@ -0,0 +1,82 @@
+#ifndef LOCOSYNC_REACTOR_HPP
+#define LOCOSYNC_REACTOR_HPP
+
+#include "locosync/options.hpp"
+#include "transfer.hpp"
+
+#include <curl/curl.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace locosync::detail {
+
+// Engine orientado a eventos: cada loop é uma thread com um CURLM dirigido por
+// curl_multi_socket_action sobre epoll (curl_multi_poll fora do Linux).
+// Milhares de transferências concorrentes rodam em um número fixo de threads.
+// Não pode ser destruído de dentro de um on_done (o loop faria join em si
+// mesmo); Client::create garante isso adiando a destruição do Client.
+class Reactor {
+public:
+    Reactor(std::size_t threads, const PoolOptions& pool_options);
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Assume a posse da Transfer (já configurada); on_done é chamado na thread do loop
+    void submit(TransferPtr transfer);
+
+private:
+    class Loop;
+
+    std::vector<std::unique_ptr<Loop>> loops;
+    std::atomic<std::size_t> next_loop{0};
+};
+
+class Reactor::Loop {
+public:
+    explicit Loop(const PoolOptions& pool_options);
+    ~Loop();
+
+    void submit(TransferPtr transfer);
+
+private:
+    void run();
+    void wakeup();
+    void drain_submissions();
+    void check_completed();
+    void abort_all(const char* reason);
+
+    CURLM* multi{nullptr};
+
+#ifdef __linux__
+    static int on_socket(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp);
+    static int on_timer(CURLM* multi, long timeout_ms, void* userp);
+
+    int epoll_fd{-1};
+    int wake_fd{-1};
+
+    // Prazo do timer pedido pelo cURL via CURLMOPT_TIMERFUNCTION
+    bool timer_armed{false};
+    std::chrono::steady_clock::time_point timer_deadline;
+#endif
+
+    std::mutex queue_mutex;
+    std::vector<TransferPtr> submitted;
+    std::vector<TransferPtr> pending; // lote em processamento (troca com submitted)
+
+    // Transferências em andamento; Transfer::active_index aponta a posição.
+    // Vetor com remoção por troca: sem alocação por requisição.
+    std::vector<TransferPtr> active;
+
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+};
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_REACTOR_HPP
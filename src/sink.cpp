@@ -0,0 +1,82 @@
+#include "locosync/sink.hpp"
+
+#include <cerrno>
+#include <ostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace locosync {
+
+namespace {
+
+class CallbackSink : public BodySink {
+public:
+    explicit CallbackSink(std::function<bool(std::string_view)> fn) : fn(std::move(fn)) {}
+
+    bool write(const char* data, std::size_t size) override {
+        return fn ? fn(std::string_view(data, size)) : true;
+    }
+
+private:
+    std::function<bool(std::string_view)> fn;
+};
+
+class FdSink : public BodySink {
+public:
+    explicit FdSink(int fd) : fd(fd) {}
+
+    bool write(const char* data, std::size_t size) override {
+        while (size > 0) {
+#ifdef _WIN32
+            const int n = ::_write(fd, data, static_cast<unsigned>(size));
+#else
+            const ssize_t n = ::write(fd, data, size);
+#endif
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+private:
+    int fd;
+};
+
+class OstreamSink : public BodySink {
+public:
+    explicit OstreamSink(std::ostream& out) : out(out) {}
+
+    bool write(const char* data, std::size_t size) override {
+        out.write(data, static_cast<std::streamsize>(size));
+        return static_cast<bool>(out);
+    }
+
+    void finish(bool) override { out.flush(); }
+
+private:
+    std::ostream& out;
+};
+
+} // namespace
+
+std::shared_ptr<BodySink> callback_sink(std::function<bool(std::string_view)> on_chunk) {
+    return std::make_shared<CallbackSink>(std::move(on_chunk));
+}
+
+std::shared_ptr<BodySink> fd_sink(int fd) {
+    return std::make_shared<FdSink>(fd);
+}
+
+std::shared_ptr<BodySink> ostream_sink(std::ostream& out) {
+    return std::make_shared<OstreamSink>(out);
+}
+
+} // namespace locosync
@@ -0,0 +1,331 @@
+#include "transfer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+namespace locosync::detail {
+
+// Callback para capturar o corpo da resposta
+static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t totalSize = size * nmemb;
+    auto* body = static_cast<std::string*>(userp);
+    try {
+        body->append(static_cast<char*>(contents), totalSize);
+        return totalSize;
+    } catch (...) { return 0; }
+}
+
+// Callback de streaming: entrega cada pedaço (já descompactado) ao sink da requisição
+static size_t SinkWriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t totalSize = size * nmemb;
+    auto* t = static_cast<Transfer*>(userp);
+    try {
+        if (!t->request.sink->write(static_cast<const char*>(contents), totalSize)) return 0;
+        t->response.decoded_bytes += totalSize;
+        return totalSize;
+    } catch (...) { return 0; }
+}
+
+// Progresso: aborta a transferência quando o sinal de cancelamento é ligado
+static int ProgressCallback(void* clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    const auto* cancel = static_cast<const std::atomic<bool>*>(clientp);
+    return cancel->load(std::memory_order_relaxed) ? 1 : 0;
+}
+
+// Corpos até este tamanho seguem junto com os headers (POSTFIELDS, sem cópia)
+static constexpr std::size_t kInlineBodyLimit = 64 * 1024;
+
+// Upload em streaming: o cURL lê o corpo direto da memória do Body
+static size_t ReadCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
+    auto* t = static_cast<Transfer*>(userdata);
+    const std::string_view body = t->request.body.view();
+    const size_t n = std::min(size * nitems, body.size() - t->upload_offset);
+    std::memcpy(buffer, body.data() + t->upload_offset, n);
+    t->upload_offset += n;
+    return n;
+}
+
+// Permite ao cURL reenviar o corpo (redirect, autenticação, conexão reaberta)
+static int SeekCallback(void* userdata, curl_off_t offset, int origin) {
+    auto* t = static_cast<Transfer*>(userdata);
+    if (origin != SEEK_SET || offset < 0 || static_cast<size_t>(offset) > t->request.body.size()) {
+        return CURL_SEEKFUNC_CANTSEEK;
+    }
+    t->upload_offset = static_cast<size_t>(offset);
+    return CURL_SEEKFUNC_OK;
+}
+
+// Limite para pré-alocar o corpo a partir do Content-Length (servidor não confiável)
+static constexpr std::size_t kMaxBodyReserve = 64 * 1024 * 1024;
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static std::string_view trim(std::string_view s) {
+    while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+    while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+// Callback para capturar e parsear Headers de resposta (sem strings temporárias)
+static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
+    size_t totalSize = size * nitems;
+    auto* t = static_cast<Transfer*>(userdata);
+    Response& res = t->response;
+    const std::string_view line(buffer, totalSize);
+
+    try {
+        // Nova linha de status (redirect, 100-continue): descarta os headers anteriores
+        if (line.size() >= 5 && line.compare(0, 5, "HTTP/") == 0) {
+            res.headers.clear();
+            res.raw_headers.clear();
+            res.header_index.clear();
+            return totalSize;
+        }
+
+        const size_t colonPos = line.find(':');
+        if (colonPos == std::string_view::npos) return totalSize;
+
+        const std::string_view key = trim(line.substr(0, colonPos));
+        const std::string_view value = trim(line.substr(colonPos + 1));
+        if (key.empty()) return totalSize;
+
+        // Content-Length conhecido: o corpo cresce uma única vez
+        if (!t->request.sink && iequals(key, "Content-Length")) {
+            std::size_t length = 0;
+            auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+            if (ec == std::errc() && end == value.data() + value.size()) {
+                res.body.reserve(std::min(length, kMaxBodyReserve));
+            }
+        }
+
+        if (t->flat_headers) {
+            if (res.raw_headers.capacity() == 0) res.raw_headers.reserve(1024);
+            if (res.header_index.capacity() == 0) res.header_index.reserve(16);
+
+            HeaderSpan span;
+            span.name_offset = static_cast<std::uint32_t>(res.raw_headers.size());
+            span.name_size = static_cast<std::uint32_t>(key.size());
+            res.raw_headers.append(key);
+            span.value_offset = static_cast<std::uint32_t>(res.raw_headers.size());
+            span.value_size = static_cast<std::uint32_t>(value.size());
+            res.raw_headers.append(value);
+            res.header_index.push_back(span);
+        } else {
+            res.headers.insert_or_assign(std::string(key), std::string(value));
+        }
+    } catch (...) { return 0; }
+    return totalSize;
+}
+
+Transfer::~Transfer() {
+    if (header_list) curl_slist_free_all(header_list);
+}
+
+void Transfer::reset() {
+    if (header_list) {
+        curl_slist_free_all(header_list);
+        header_list = nullptr;
+    }
+    request = Request{};
+    response = Response{};
+    lease.reset();
+    on_done = nullptr;
+    queued_at = {};
+    started_at = {};
+    cancel.reset();
+    multiplex = false;
+    flat_headers = false;
+    cache = CacheTicket{};
+    scratch.clear(); // mantém a capacidade
+    upload_offset = 0;
+    active_index = 0;
+}
+
+// --- TransferPool ---
+
+void TransferRecycler::operator()(Transfer* t) const {
+    if (pool) pool->recycle(t);
+    else delete t;
+}
+
+TransferPtr TransferPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!cached.empty()) {
+            Transfer* t = cached.back().release();
+            cached.pop_back();
+            return TransferPtr(t, TransferRecycler{this});
+        }
+    }
+    return TransferPtr(new Transfer(), TransferRecycler{this});
+}
+
+void TransferPool::recycle(Transfer* t) {
+    std::unique_ptr<Transfer> owned(t);
+    // Devolve o handle ao pool de conexões antes de guardar a Transfer
+    owned->reset();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cached.size() < max_cached) {
+        if (cached.capacity() == 0) cached.reserve(max_cached);
+        cached.push_back(std::move(owned));
+    }
+}
+
+void configure(Transfer& t, const ClientOptions& options) {
+    CURL* curl = t.lease.get();
+    const Request& req = t.request;
+
+    // --- HARDENING DE SEGURANÇA ---
+    curl_easy_setopt(curl, CURLOPT_URL, req.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_PROTOCOLS, CURLPROTO_HTTP | CURLPROTO_HTTPS);
+    curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2); // mínimo TLS 1.2
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+    // Timeouts
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, req.timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, req.connect_timeout_ms);
+
+    // Keep-Alive: conexões ociosas além do limite do pool não são reutilizadas
+    const auto idle_secs = std::chrono::duration_cast<std::chrono::seconds>(options.pool.idle_timeout).count();
+    curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN, static_cast<long>(std::max<long long>(idle_secs, 1)));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+
+    // HTTP/2 via ALPN; com multiplex, espera a conexão existente em vez de abrir outra
+    if (t.multiplex) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
+    // Accept-Encoding com os decodificadores do build; "" = todos. O cURL
+    // descompacta em streaming antes dos callbacks de escrita.
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, options.compression.accept_encoding ? "" : nullptr);
+
+    // Obrigatório em programas multi-thread: sinais não podem ser usados para timeouts de DNS
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    // Método HTTP
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, req.method_string().c_str());
+
+    // Headers (montados no buffer de trabalho da Transfer, sem temporários)
+    for (const auto& kv : req.headers) {
+        t.scratch.assign(kv.first).append(": ").append(kv.second);
+        t.header_list = curl_slist_append(t.header_list, t.scratch.c_str());
+    }
+
+    // Body / Payload: o cURL lê direto da memória do Body, sem cópia.
+    // Corpos pequenos vão com POSTFIELDS (mesmo envio dos headers); os grandes
+    // são lidos em streaming pelo ReadCallback. UPLOAD + CUSTOMREQUEST mantém
+    // o método da requisição (POST, PATCH...).
+    if (!req.body.empty()) {
+        if (req.body.size() <= kInlineBodyLimit) {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req.body.data());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(req.body.size()));
+        } else {
+            t.upload_offset = 0;
+            curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(curl, CURLOPT_READFUNCTION, ReadCallback);
+            curl_easy_setopt(curl, CURLOPT_READDATA, &t);
+            curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, SeekCallback);
+            curl_easy_setopt(curl, CURLOPT_SEEKDATA, &t);
+            curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(req.body.size()));
+
+            // Sem "Expect: 100-continue": evita uma espera extra antes de enviar o corpo
+            if (req.headers.find("Expect") == req.headers.end()) {
+                t.header_list = curl_slist_append(t.header_list, "Expect:");
+            }
+        }
+
+        if (req.headers.find("Content-Type") == req.headers.end()) {
+            t.header_list = curl_slist_append(t.header_list, "Content-Type: application/json");
+        }
+    }
+
+    if (t.header_list) curl_easy_setopt(curl, CURLOPT_HTTPHEADER, t.header_list);
+
+    // Callbacks para corpo e headers
+    if (req.sink) {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, SinkWriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &t);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &t.response.body);
+    }
+    t.flat_headers = options.response_layout == ResponseLayout::Flat;
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &t);
+
+    if (t.cancel) {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, t.cancel.get());
+    }
+
+    // Permite ao engine reativo recuperar a Transfer a partir do handle
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, &t);
+}
+
+void collect(Transfer& t, CURLcode code) {
+    CURL* curl = t.lease.get();
+    Response& res = t.response;
+
+    if (code != CURLE_OK) {
+        res.error_message = curl_easy_strerror(code);
+    } else {
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        res.status_code = static_cast<int>(http_code);
+
+        double elapsed = 0.0;
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &elapsed);
+        res.elapsed_time = elapsed;
+    }
+
+    // Bytes do corpo na rede (antes da descompressão) e entregues
+    curl_off_t wire = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+    res.wire_bytes = wire > 0 ? static_cast<std::uint64_t>(wire) : 0;
+    if (!t.request.sink) res.decoded_bytes = res.body.size();
+
+    // --- TIMINGS POR FASE ---
+    // Os timers do cURL são acumulados desde o início (microssegundos);
+    // cada fase é a diferença entre marcos consecutivos.
+    curl_off_t namelookup = 0, connect = 0, appconnect = 0, pretransfer = 0, starttransfer = 0, total = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &namelookup);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appconnect);
+    curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &pretransfer);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &starttransfer);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+
+    auto seconds = [](curl_off_t from, curl_off_t to) {
+        return to > from ? static_cast<double>(to - from) / 1e6 : 0.0;
+    };
+    Timings& timings = res.timings;
+    timings.dns = seconds(0, namelookup);
+    timings.connect = seconds(namelookup, connect);
+    timings.tls = appconnect > 0 ? seconds(connect, appconnect) : 0.0;
+    timings.ttfb = starttransfer > 0 ? seconds(pretransfer, starttransfer) : 0.0;
+    timings.transfer = starttransfer > 0 ? seconds(starttransfer, total) : 0.0;
+    timings.total = seconds(0, total);
+    if (t.started_at > t.queued_at && t.queued_at != std::chrono::steady_clock::time_point{}) {
+        timings.queue = std::chrono::duration<double>(t.started_at - t.queued_at).count();
+    }
+
+    if (const auto& sink = t.request.sink) {
+        sink->finish(code == CURLE_OK);
+        // Erro do próprio sink (ex: JSON inválido) é mais útil que "Failed writing received data"
+        std::string sink_error = sink->error();
+        if (!sink_error.empty()) res.error_message = std::move(sink_error);
+    }
+}
+
+} // namespace locosync::detail
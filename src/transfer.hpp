@@ -0,0 +1,99 @@
+#ifndef LOCOSYNC_TRANSFER_HPP
+#define LOCOSYNC_TRANSFER_HPP
+
+#include "locosync/options.hpp"
+#include "locosync/request.hpp"
+#include "locosync/response.hpp"
+#include "connection_pool.hpp"
+#include "http_cache.hpp"
+
+#include <curl/curl.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace locosync::detail {
+
+// Estado de uma transferência em andamento, compartilhado pelos engines
+struct Transfer {
+    Request request;
+    Response response;
+    Lease lease;
+    struct curl_slist* header_list{nullptr};
+
+    // Chamado pelo engine quando a transferência termina (após collect())
+    std::function<void(Transfer&)> on_done;
+
+    // Entrada no engine e início efetivo no cURL (Timings::queue)
+    std::chrono::steady_clock::time_point queued_at;
+    std::chrono::steady_clock::time_point started_at;
+
+    // Sinal de cancelamento (hedging): a tentativa perdedora é abortada
+    std::shared_ptr<std::atomic<bool>> cancel;
+    bool cancelled() const { return cancel && cancel->load(std::memory_order_relaxed); }
+
+    // Aguarda para multiplexar numa conexão HTTP/2 existente (lotes)
+    bool multiplex{false};
+
+    // Layout dos headers de resposta (ClientOptions::response_layout)
+    bool flat_headers{false};
+
+    // Buffer de trabalho reaproveitado entre requisições (linhas "Nome: valor")
+    std::string scratch;
+
+    // Chave/entrada do cache HTTP para esta requisição (se houver cache)
+    CacheTicket cache;
+
+    // Bytes do corpo da requisição já entregues ao cURL (upload em streaming)
+    std::size_t upload_offset{0};
+
+    // Posição na lista de transferências ativas do reactor
+    std::size_t active_index{0};
+
+    Transfer() = default;
+    Transfer(const Transfer&) = delete;
+    Transfer& operator=(const Transfer&) = delete;
+    ~Transfer();
+
+    // Volta ao estado inicial preservando a capacidade dos buffers de trabalho
+    void reset();
+};
+
+class TransferPool;
+
+// Devolve a Transfer ao pool (arena) em vez de liberá-la
+struct TransferRecycler {
+    TransferPool* pool{nullptr};
+    void operator()(Transfer* t) const;
+};
+
+using TransferPtr = std::unique_ptr<Transfer, TransferRecycler>;
+
+// Arena de Transfers reutilizadas entre requisições: evita alocar o objeto,
+// os buffers de trabalho e o índice de headers a cada chamada.
+class TransferPool {
+public:
+    explicit TransferPool(std::size_t max_cached = 256) : max_cached(max_cached) {}
+
+    TransferPtr acquire();
+    void recycle(Transfer* t);
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Transfer>> cached;
+    std::size_t max_cached;
+};
+
+// Aplica as opções da requisição (segurança, timeouts, headers, body) no handle emprestado
+void configure(Transfer& t, const ClientOptions& options);
+
+// Preenche status, tempo e erro a partir do resultado do cURL
+void collect(Transfer& t, CURLcode code);
+
+} // namespace locosync::detail
+
+#endif // LOCOSYNC_TRANSFER_HPP
@@ -0,0 +1,1257 @@
+// Testes da LocoSync: executável único, sem framework externo.
+//
+//   locosync_tests [filtro]   roda os testes cujo nome contém `filtro`
+//
+// Cada TEST registra uma função; CHECK registra a falha e segue em frente.
+#include "locosync/locosync.hpp"
+#include "compression.hpp"
+#include "hedging.hpp"
+#include "metrics.hpp"
+#include "http_cache.hpp"
+#include "reactor.hpp"
+#include "transfer.hpp"
+#ifdef LOCOSYNC_TEST_LOOPBACK
+#include "loopback_server.hpp"
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// --- MINI FRAMEWORK ---
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+int failures = 0;
+
+bool register_test(const char* name, void (*run)()) {
+    registry().push_back({name, run});
+    return true;
+}
+
+void report_failure(const char* file, int line, const std::string& what) {
+    ++failures;
+    std::cerr << file << ":" << line << ": falhou: " << what << "\n";
+}
+
+#define TEST(name)                                                   \
+    void name();                                                     \
+    [[maybe_unused]] const bool name##_registered = register_test(#name, &name); \
+    void name()
+
+#define CHECK(cond)                                                  \
+    do {                                                             \
+        if (!(cond)) report_failure(__FILE__, __LINE__, #cond);      \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                               \
+    do {                                                             \
+        if (!((a) == (b))) report_failure(__FILE__, __LINE__, #a " == " #b); \
+    } while (0)
+
+using json = nlohmann::json;
+
+// --- JsonPushParser ---
+
+// Handler SAX que monta o DOM (para comparar com json::parse)
+class DomSax : public nlohmann::json_sax<json> {
+public:
+    explicit DomSax(json& out) : dom(out, false) {}
+
+    bool null() override { return dom.null(); }
+    bool boolean(bool v) override { return dom.boolean(v); }
+    bool number_integer(number_integer_t v) override { return dom.number_integer(v); }
+    bool number_unsigned(number_unsigned_t v) override { return dom.number_unsigned(v); }
+    bool number_float(number_float_t v, const string_t& s) override { return dom.number_float(v, s); }
+    bool string(string_t& v) override { return dom.string(v); }
+    bool binary(binary_t& v) override { return dom.binary(v); }
+    bool start_object(std::size_t n) override { return dom.start_object(n); }
+    bool key(string_t& k) override { return dom.key(k); }
+    bool end_object() override { return dom.end_object(); }
+    bool start_array(std::size_t n) override { return dom.start_array(n); }
+    bool end_array() override { return dom.end_array(); }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    nlohmann::detail::json_sax_dom_parser<json> dom;
+};
+
+// Alimenta o parser em pedaços de `chunk` bytes; nullopt em erro
+std::optional<json> push_parse(const std::string& text, std::size_t chunk, std::string* error = nullptr) {
+    json out;
+    DomSax sax(out);
+    locosync::JsonPushParser parser(sax);
+    bool ok = true;
+    for (std::size_t i = 0; ok && i < text.size(); i += chunk) {
+        ok = parser.feed(text.data() + i, std::min(chunk, text.size() - i));
+    }
+    ok = ok && parser.finish();
+    if (error) *error = parser.error();
+    if (!ok) return std::nullopt;
+    return out;
+}
+
+// Mesmo resultado de json::parse (ou mesma rejeição) em qualquer fatiamento
+void check_like_nlohmann(const std::string& text) {
+    const bool accepted = json::accept(text);
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{2}, std::size_t{3}, std::size_t{7}, std::size_t{64},
+                              text.size() + 1}) {
+        const auto parsed = push_parse(text, chunk);
+        if (parsed.has_value() != accepted) {
+            report_failure(__FILE__, __LINE__, "aceitação diferente de json::accept para " + text);
+            return;
+        }
+        if (parsed && *parsed != json::parse(text)) {
+            report_failure(__FILE__, __LINE__, "valor diferente de json::parse para " + text);
+            return;
+        }
+    }
+}
+
+TEST(json_stream_chunk_boundaries) {
+    const std::vector<std::string> documents = {
+        R"({"count":3,"results":[{"name":"bulbasaur","url":"https://x/1"},{"name":"ivysaur"},null]})",
+        R"([1,-2,3.5,-0.25e-3,true,false,null,"",{},[],[[]],{"a":{"b":{"c":[1,{"d":"e"}]}}}])",
+        " \t\r\n{ \"spaced\" : [ 1 , 2 ] , \"k\" : \"v\" } \n",
+        R"("texto com acentuação: çãé 日本語 🚀")",
+        "123456789",
+        "-0",
+        "true",
+        "null",
+    };
+    for (const auto& doc : documents) check_like_nlohmann(doc);
+
+    // Documento grande: muitos tokens atravessando fronteiras de pedaço
+    json big = json::array();
+    for (int i = 0; i < 500; ++i) {
+        big.push_back({{"id", i}, {"name", "item-" + std::to_string(i) + "-ç"}, {"price", i * 0.5}, {"ok", i % 2 == 0}});
+    }
+    check_like_nlohmann(big.dump());
+}
+
+TEST(json_stream_escapes_and_surrogates) {
+    check_like_nlohmann(R"("\" \\ \/ \b \f \n \r \t")");
+    check_like_nlohmann(R"("Aé€🚀")");
+    check_like_nlohmann(R"({"key":"v"})");
+
+    const auto parsed = push_parse(R"("🚀")", 1);
+    CHECK(parsed && parsed->get<std::string>() == "\xF0\x9F\x9A\x80");
+
+    // Inválidos: surrogates soltos ou invertidos, escapes desconhecidos, controle cru
+    for (const std::string bad : {R"("\ud83d")", R"("\ud83dx")", R"("\ud83d\n")", R"("\ude80")",
+                                  R"("\ude80\ud83d")", R"("\x41")", R"("\u12")", R"("\u12G4")", "\"a\nb\""}) {
+        CHECK(!json::accept(bad));
+        CHECK(!push_parse(bad, 1));
+        CHECK(!push_parse(bad, bad.size()));
+    }
+}
+
+TEST(json_stream_utf8_validation) {
+    // Válidos: 2, 3 e 4 bytes, inclusive nos limites da tabela da RFC 3629
+    check_like_nlohmann("\"\xC3\xA9\"");
+    check_like_nlohmann("\"\xE0\xA0\x80\xED\x9F\xBF\xEE\x80\x80\"");
+    check_like_nlohmann("\"\xF0\x90\x80\x80\xF4\x8F\xBF\xBF\"");
+
+    // Inválidos: truncado, forma longa, surrogate codificado, acima de U+10FFFF, byte solto
+    for (const std::string bad : {"\"\xC3\"", "\"\xC3x\"", "\"\xC0\x80\"", "\"\xE0\x80\x80\"", "\"\xED\xA0\x80\"",
+                                  "\"\xF4\x90\x80\x80\"", "\"\xF5\x80\x80\x80\"", "\"\x80\"", "\"\xFF\"",
+                                  "\"\xE2\x82\\n\""}) {
+        CHECK(!json::accept(bad));
+        std::string error;
+        CHECK(!push_parse(bad, 1, &error));
+        CHECK(!push_parse(bad, bad.size()));
+        CHECK(error.find("UTF-8") != std::string::npos);
+    }
+}
+
+TEST(json_stream_numbers) {
+    for (const std::string doc : {"0", "-0", "0.5", "-0.0", "1e2", "1E+2", "2.5e-3", "9223372036854775807",
+                                  "-9223372036854775808", "18446744073709551615", "18446744073709551616",
+                                  "-9223372036854775809", "1e-400", "-1e-400", "1.7976931348623157e308"}) {
+        check_like_nlohmann(doc);
+        check_like_nlohmann("[" + doc + "]");
+    }
+    for (const std::string bad : {"01", "-", "1.", ".5", "+1", "1e", "1e+", "1.5e", "--1", "0x10", "1e400", "-1e400"}) {
+        check_like_nlohmann(bad);
+        check_like_nlohmann("[" + bad + "]");
+    }
+
+    const auto big = push_parse("[18446744073709551615,18446744073709551616,-9223372036854775808]", 1);
+    CHECK(big && (*big)[0].is_number_unsigned() && (*big)[1].is_number_float() && (*big)[2].is_number_integer());
+}
+
+TEST(json_stream_numbers_ignore_locale) {
+    // Locale com vírgula decimal, se houver algum instalado
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    for (const char* name : {"pt_BR.UTF-8", "pt_BR.utf8", "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8"}) {
+        if (std::setlocale(LC_NUMERIC, name)) break;
+    }
+    const auto parsed = push_parse("[1.25,-3.5e1]", 1);
+    CHECK(parsed && (*parsed)[0].get<double>() == 1.25 && (*parsed)[1].get<double>() == -35.0);
+    std::setlocale(LC_NUMERIC, previous.c_str());
+}
+
+TEST(json_stream_truncated_input) {
+    const std::string doc = R"({"a":[1,2.5,"xéy",true,null,{"b":false}],"c":"d"})";
+    // Nenhum prefixo próprio de um objeto é um documento completo
+    for (std::size_t n = 0; n < doc.size(); ++n) {
+        const std::string prefix = doc.substr(0, n);
+        CHECK(!json::accept(prefix));
+        std::string error;
+        CHECK(!push_parse(prefix, 1, &error));
+        CHECK(!error.empty());
+    }
+    CHECK(push_parse(doc, 1).has_value());
+
+    // Dados depois do documento
+    CHECK(!push_parse(R"({"a":1} {"b":2})", 1));
+    CHECK(!push_parse("[1]]", 1));
+    CHECK(!push_parse("", 1));
+}
+
+// Handler que para depois de `limit` eventos
+class StopAfter : public DomSax {
+public:
+    StopAfter(json& out, int limit) : DomSax(out), limit(limit) {}
+
+    int events{0};
+    bool null() override { return step() && DomSax::null(); }
+    bool number_unsigned(number_unsigned_t v) override { return step() && DomSax::number_unsigned(v); }
+    bool start_array(std::size_t n) override { return step() && DomSax::start_array(n); }
+    bool end_array() override { return step() && DomSax::end_array(); }
+
+private:
+    bool step() { return ++events <= limit; }
+    int limit;
+};
+
+TEST(json_stream_handler_abort) {
+    json out;
+    StopAfter sax(out, 3); // [ 1 2 -> para no 3
+    locosync::JsonPushParser parser(sax);
+    const std::string doc = "[1,2,3,4,null]";
+    bool ok = true;
+    std::size_t fed = 0;
+    for (; ok && fed < doc.size(); ++fed) ok = parser.feed(doc.data() + fed, 1);
+    CHECK(!ok);
+    CHECK_EQ(sax.events, 4);
+    CHECK(parser.failed());
+    CHECK_EQ(parser.error(), std::string("JSON parsing stopped by handler"));
+    // Depois de parar, nada mais chega ao handler
+    CHECK(!parser.feed("]", 1));
+    CHECK(!parser.finish());
+    CHECK_EQ(sax.events, 4);
+
+    // json_array_sink: retornar false no callback aborta a escrita
+    std::vector<json> seen;
+    auto sink = locosync::json_array_sink("/results", [&](json&& element) {
+        seen.push_back(std::move(element));
+        return seen.size() < 2;
+    });
+    const std::string body = R"({"count":3,"results":[{"n":1},{"n":2},{"n":3}]})";
+    bool written = true;
+    for (std::size_t i = 0; written && i < body.size(); ++i) written = sink->write(body.data() + i, 1);
+    CHECK(!written);
+    CHECK_EQ(seen.size(), std::size_t{2});
+}
+
+TEST(json_stream_array_sink_elements) {
+    const std::string body = R"({"meta":{"results":[0]},"results":[{"n":1,"tags":["a","b"]},2,"três",[4],null],"tail":1})";
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{5}, body.size()}) {
+        std::vector<json> seen;
+        auto sink = locosync::json_array_sink("/results", [&](json&& element) {
+            seen.push_back(std::move(element));
+            return true;
+        });
+        bool ok = true;
+        for (std::size_t i = 0; ok && i < body.size(); i += chunk) {
+            ok = sink->write(body.data() + i, std::min(chunk, body.size() - i));
+        }
+        sink->finish(ok);
+        CHECK(ok);
+        CHECK(sink->error().empty());
+        CHECK_EQ(json(seen), json::parse(body)["results"]);
+    }
+}
+
+// --- DECODE TIPADO ---
+
+TEST(decode_character_types) {
+    const auto bytes = locosync::decode_json<std::vector<char>>("[65, 0, 127]");
+    CHECK_EQ(bytes.size(), 3u);
+    CHECK(bytes == std::vector<char>({'A', '\0', '\x7f'}));
+    CHECK(!locosync::try_decode_json<std::vector<signed char>>("[128]"));
+    CHECK(!locosync::try_decode_json<std::vector<unsigned char>>("[-1]"));
+    CHECK(locosync::decode_json<std::vector<unsigned char>>("[255]").front() == 255);
+    CHECK(locosync::decode_json<char8_t>("97") == u8'a');
+    CHECK(!locosync::try_decode_json<char16_t>("65536"));
+    CHECK(locosync::decode_json<char32_t>("128512") == U'\U0001F600');
+    CHECK(locosync::decode_json<wchar_t>("65") == L'A');
+}
+
+TEST(response_json_cache) {
+    static_assert(std::is_nothrow_move_constructible_v<locosync::Response>);
+    static_assert(std::is_nothrow_move_assignable_v<locosync::Response>);
+
+    locosync::Response res;
+    res.body = R"({"count": 1, "padding": "evita o buffer inline da std::string"})";
+    const nlohmann::json* first = &res.json_ref();
+    CHECK_EQ((*first)["count"].get<int>(), 1);
+    CHECK(&res.json_ref() == first);
+
+    const locosync::Response copy = res;
+    CHECK(&copy.json_ref() == first); // cópia herda o DOM sem parsear
+
+    res.body = R"({"count": 22, "padding": "evita o buffer inline da std::string"})";
+    CHECK_EQ(res.json()["count"].get<int>(), 22);
+    CHECK_EQ(copy.json()["count"].get<int>(), 1);
+
+    // Mesmo tamanho: reatribuição (buffer reaproveitado) e edição no lugar
+    res.body = R"({"count": 33, "padding": "evita o buffer inline da std::string"})";
+    CHECK_EQ(res.json()["count"].get<int>(), 33);
+    res.body[11] = '4';
+    CHECK_EQ(res.json()["count"].get<int>(), 34);
+
+    // O body da cópia muda sem afetar o DOM da original
+    locosync::Response other = copy;
+    other.body = R"({"count": 5, "padding": "evita o buffer inline da std::string"})";
+    CHECK_EQ(other.json()["count"].get<int>(), 5);
+    CHECK_EQ(copy.json()["count"].get<int>(), 1);
+
+    res.body = R"({"a":1})";
+    CHECK_EQ(res.json()["a"].get<int>(), 1);
+    res.body = R"({"a":2})";
+    CHECK_EQ(res.json()["a"].get<int>(), 2);
+
+    // json() por valor: operator[] não-const numa chave ausente continua valendo
+    CHECK(res.json()["missing"].is_null());
+
+    res.body = "{";
+    CHECK_EQ(res.json()["error"].get<std::string>(), std::string("invalid_json"));
+    res.body.clear();
+    CHECK(res.json().is_object() && res.json().empty());
+
+    // Primeiras chamadas simultâneas devolvem o mesmo DOM
+    locosync::Response shared;
+    shared.body = "[1, 2, 3]";
+    std::vector<const nlohmann::json*> seen(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&, i] { seen[i] = &shared.json_ref(); });
+    }
+    for (auto& t : threads) t.join();
+    for (const auto* p : seen) CHECK(p == seen.front());
+    CHECK_EQ(seen.front()->size(), 3u);
+}
+
+// --- HEDGING ---
+
+TEST(body_share_avoids_copies) {
+    locosync::Request req;
+    req.body = std::string(1 << 20, 'p');
+    req.body.share();
+    CHECK_EQ(req.body.size(), std::size_t{1} << 20);
+
+    // Cópias da Request apontam para os mesmos bytes, que vivem enquanto houver uma
+    locosync::Request copy = req;
+    CHECK(copy.body.data() == req.body.data());
+    req = locosync::Request{};
+    CHECK_EQ(copy.body.view(), std::string(1 << 20, 'p'));
+
+    // Corpo emprestado continua emprestado
+    const std::string external = "emprestado";
+    locosync::Body borrowed = locosync::Body::borrow(external);
+    borrowed.share();
+    CHECK(borrowed.data() == external.data());
+}
+
+TEST(timer_queue_cancel_releases_task) {
+    locosync::detail::TimerQueue timers;
+    auto payload = std::make_shared<int>(7);
+    std::atomic<int> ran{0};
+
+    const auto id = timers.schedule(std::chrono::steady_clock::now() + std::chrono::hours(1),
+                                    [payload, &ran] { ran += *payload; });
+    timers.schedule(std::chrono::steady_clock::now(), [&ran] { ran += 1; });
+    CHECK_EQ(payload.use_count(), 2L);
+    timers.cancel(id);
+    CHECK_EQ(payload.use_count(), 1L);
+    timers.cancel(id); // já removida: nada acontece
+
+    for (int i = 0; i < 200 && ran.load() == 0; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK_EQ(ran.load(), 1);
+}
+
+// --- CACHE HTTP EM DISCO ---
+
+#ifndef _WIN32 // camada em disco só existe em POSIX
+
+namespace fs = std::filesystem;
+using locosync::detail::HttpCache;
+
+// Arquivo temporário removido no fim do teste
+struct TempFile {
+    explicit TempFile(const std::string& name)
+        : path(fs::temp_directory_path() / ("locosync_test_" + std::to_string(::getpid()) + "_" + name)) {
+        fs::remove(path);
+    }
+    ~TempFile() {
+        std::error_code ec;
+        fs::remove(path, ec);
+        fs::remove(path.string() + ".tmp", ec);
+    }
+    fs::path path;
+};
+
+std::unique_ptr<HttpCache> open_cache(const fs::path& path, std::size_t max_bytes = 64 * 1024 * 1024) {
+    locosync::CacheOptions options;
+    options.enabled = true;
+    options.disk_path = path.string();
+    options.max_bytes = max_bytes;
+    return std::make_unique<HttpCache>(options, locosync::ResponseLayout::Map);
+}
+
+// Simula uma resposta 200 da rede para `url`. Para substituir uma entrada a
+// anterior precisa estar vencida (ex: "no-cache"), senão o lookup a serve.
+void store(HttpCache& cache, const std::string& url, const std::string& body,
+           const std::string& cache_control = "max-age=3600") {
+    locosync::Request req;
+    req.url = url;
+    locosync::Response out;
+    locosync::detail::CacheTicket ticket;
+    CHECK(!cache.lookup(req, out, ticket));
+
+    locosync::Response res;
+    res.status_code = 200;
+    res.headers["Cache-Control"] = cache_control;
+    res.headers["ETag"] = "\"" + std::to_string(body.size()) + "\"";
+    res.headers["Content-Type"] = "application/json";
+    res.body = body;
+    cache.complete(ticket, res);
+}
+
+// Corpo servido sem ir à rede, se houver
+std::optional<std::string> fetch(HttpCache& cache, const std::string& url) {
+    locosync::Request req;
+    req.url = url;
+    locosync::Response out;
+    locosync::detail::CacheTicket ticket;
+    if (!cache.lookup(req, out, ticket)) return std::nullopt;
+    return out.body;
+}
+
+TEST(disk_cache_survives_restart) {
+    TempFile file("restart.bin");
+    {
+        auto cache = open_cache(file.path);
+        store(*cache, "https://api/a", "corpo A", "no-cache");
+        store(*cache, "https://api/b", std::string(100000, 'b'));
+        store(*cache, "https://api/a", "corpo A v2"); // o último registro da chave vence
+    }
+
+    auto cache = open_cache(file.path);
+    CHECK_EQ(fetch(*cache, "https://api/a"), std::optional<std::string>("corpo A v2"));
+    CHECK_EQ(fetch(*cache, "https://api/b"), std::optional<std::string>(std::string(100000, 'b')));
+    CHECK(!fetch(*cache, "https://api/c"));
+    CHECK_EQ(cache->stats().disk_hits, std::uint64_t{2});
+
+    locosync::Request req;
+    req.url = "https://api/a";
+    locosync::Response out;
+    locosync::detail::CacheTicket ticket;
+    CHECK(cache->lookup(req, out, ticket));
+    CHECK_EQ(out.header("Content-Type"), std::string_view("application/json"));
+}
+
+TEST(disk_cache_torn_tail_recovery) {
+    TempFile file("torn.bin");
+    TempFile pristine("torn_pristine.bin");
+    std::uintmax_t first_end = 0;
+    {
+        auto cache = open_cache(pristine.path);
+        store(*cache, "https://api/a", "primeiro");
+        cache->flush(); // gravação em disco é assíncrona
+        first_end = fs::file_size(pristine.path);
+        store(*cache, "https://api/b", std::string(4096, 'x'));
+    }
+    const std::uintmax_t full = fs::file_size(pristine.path);
+    const std::uintmax_t second = full - first_end;
+
+    // Escrita interrompida em qualquer ponto do segundo registro: cabeçalho,
+    // chave, headers ou corpo
+    for (std::uintmax_t cut : {std::uintmax_t{1}, std::uintmax_t{100}, second - 40, second - 8, second - 1}) {
+        fs::copy_file(pristine.path, file.path, fs::copy_options::overwrite_existing);
+        fs::resize_file(file.path, full - cut);
+        {
+            auto cache = open_cache(file.path);
+            CHECK_EQ(fetch(*cache, "https://api/a"), std::optional<std::string>("primeiro"));
+            CHECK(!fetch(*cache, "https://api/b"));
+            // A cauda é descartada e novos registros continuam dali
+            CHECK_EQ(fs::file_size(file.path), first_end);
+            store(*cache, "https://api/c", "depois da queda");
+        }
+        auto cache = open_cache(file.path);
+        CHECK_EQ(fetch(*cache, "https://api/a"), std::optional<std::string>("primeiro"));
+        CHECK_EQ(fetch(*cache, "https://api/c"), std::optional<std::string>("depois da queda"));
+    }
+
+    // Lixo depois do último registro válido (magic errado, pedaço de cabeçalho)
+    for (const auto& garbage : {std::string(3, '\x01'), std::string(64, '\xFF'), std::string(40, '\0')}) {
+        fs::copy_file(pristine.path, file.path, fs::copy_options::overwrite_existing);
+        std::ofstream(file.path, std::ios::binary | std::ios::app) << garbage;
+        auto cache = open_cache(file.path);
+        CHECK_EQ(fetch(*cache, "https://api/a"), std::optional<std::string>("primeiro"));
+        CHECK_EQ(fetch(*cache, "https://api/b"), std::optional<std::string>(std::string(4096, 'x')));
+        CHECK_EQ(fs::file_size(file.path), full);
+    }
+}
+
+TEST(disk_cache_writes_in_background) {
+    TempFile file("background.bin");
+    // Memória mínima: toda leitura passa pela camada em disco
+    auto cache = open_cache(file.path, 1024);
+    const std::string body(256 * 1024, 'd');
+    for (int i = 1; i < 8; ++i) {
+        const std::string url = "https://api/" + std::to_string(i);
+        store(*cache, url, body + std::to_string(i));
+        // Ainda na fila ou já no arquivo: a leitura vê a versão nova
+        CHECK_EQ(fetch(*cache, url), std::optional<std::string>(body + std::to_string(i)));
+    }
+    store(*cache, "https://api/0", body, "no-cache");
+    store(*cache, "https://api/0", "removida", "no-store");
+    CHECK(!fetch(*cache, "https://api/0"));
+
+    cache->flush();
+    CHECK(fs::file_size(file.path) > 8 * body.size());
+    cache.reset();
+    cache = open_cache(file.path, 1024);
+    CHECK(!fetch(*cache, "https://api/0"));
+    CHECK_EQ(fetch(*cache, "https://api/7"), std::optional<std::string>(body + "7"));
+}
+
+TEST(disk_cache_removal_and_bad_file) {
+    TempFile file("removal.bin");
+    {
+        auto cache = open_cache(file.path);
+        store(*cache, "https://api/a", "a", "no-cache");
+        store(*cache, "https://api/b", "b");
+        // Resposta não armazenável grava um registro de remoção
+        store(*cache, "https://api/a", "a2", "no-store");
+    }
+    {
+        auto cache = open_cache(file.path);
+        CHECK(!fetch(*cache, "https://api/a"));
+        CHECK_EQ(fetch(*cache, "https://api/b"), std::optional<std::string>("b"));
+    }
+
+    // Arquivo de outro formato: recomeça vazio, com o cabeçalho certo
+    std::ofstream(file.path, std::ios::binary | std::ios::trunc) << "NOTLOCO!" << std::string(200, 'z');
+    {
+        auto cache = open_cache(file.path);
+        CHECK(!fetch(*cache, "https://api/b"));
+        store(*cache, "https://api/b", "novo");
+    }
+    std::ifstream in(file.path, std::ios::binary);
+    std::string magic(8, '\0');
+    in.read(magic.data(), 8);
+    CHECK_EQ(magic, std::string("LOCOSC01"));
+    auto cache = open_cache(file.path);
+    CHECK_EQ(fetch(*cache, "https://api/b"), std::optional<std::string>("novo"));
+}
+
+#endif
+
+// --- MÉTRICAS (PROMETHEUS) ---
+
+// Limites `le` dos 132 buckets (4 por potência de 2, em microssegundos)
+const char* const kLatencyBucketBounds[] = {
+    "0.000000", "0.000001", "0.000002", "0.000003", "0.000004", "0.000005", "0.000006", "0.000007", "0.000009",
+    "0.000011", "0.000013", "0.000015", "0.000019", "0.000023", "0.000027", "0.000031", "0.000039", "0.000047",
+    "0.000055", "0.000063", "0.000079", "0.000095", "0.000111", "0.000127", "0.000159", "0.000191", "0.000223",
+    "0.000255", "0.000319", "0.000383", "0.000447", "0.000511", "0.000639", "0.000767", "0.000895", "0.001023",
+    "0.001279", "0.001535", "0.001791", "0.002047", "0.002559", "0.003071", "0.003583", "0.004095", "0.005119",
+    "0.006143", "0.007167", "0.008191", "0.010239", "0.012287", "0.014335", "0.016383", "0.020479", "0.024575",
+    "0.028671", "0.032767", "0.040959", "0.049151", "0.057343", "0.065535", "0.081919", "0.098303", "0.114687",
+    "0.131071", "0.163839", "0.196607", "0.229375", "0.262143", "0.327679", "0.393215", "0.458751", "0.524287",
+    "0.655359", "0.786431", "0.917503", "1.048575", "1.310719", "1.572863", "1.835007", "2.097151", "2.621439",
+    "3.145727", "3.670015", "4.194303", "5.242879", "6.291455", "7.340031", "8.388607", "10.485759",
+    "12.582911", "14.680063", "16.777215", "20.971519", "25.165823", "29.360127", "33.554431", "41.943039",
+    "50.331647", "58.720255", "67.108863", "83.886079", "100.663295", "117.440511", "134.217727", "167.772159",
+    "201.326591", "234.881023", "268.435455", "335.544319", "402.653183", "469.762047", "536.870911",
+    "671.088639", "805.306367", "939.524095", "1073.741823", "1342.177279", "1610.612735", "1879.048191",
+    "2147.483647", "2684.354559", "3221.225471", "3758.096383", "4294.967295", "5368.709119", "6442.450943",
+    "7516.192767", "8589.934591", "10737.418239", "12884.901887", "15032.385535", "17179.869183",
+};
+
+locosync::Response metric_sample(int status, std::uint64_t wire_bytes, double queue, double total) {
+    locosync::Response res;
+    res.status_code = status;
+    if (status == 0) res.error_message = "Couldn't connect to server";
+    res.wire_bytes = wire_bytes;
+    res.timings.queue = queue;
+    res.timings.total = total;
+    res.timings.dns = 0.125;
+    res.timings.connect = 0.0625;
+    res.timings.ttfb = 0.03125;
+    res.timings.transfer = 0.25;
+    return res;
+}
+
+TEST(prometheus_export_golden) {
+    static_assert(std::size(kLatencyBucketBounds) == locosync::detail::LatencyHistogram::kBuckets);
+    locosync::detail::MetricsRegistry registry;
+    const std::string host = "http://127.0.0.1:8080";
+    registry.record(host, metric_sample(200, 1000, 0.25, 0.5)); // 750 ms: bucket 73
+    registry.record(host, metric_sample(404, 10, 0.0, 0.0));    // 0 µs: bucket 0
+    registry.record(host, metric_sample(0, 0, 0.0, 1.0));       // 1 s: bucket 75, erro de transporte
+
+    std::string expected = R"(# HELP locosync_requests_total Transfers completed, per host.
+# TYPE locosync_requests_total counter
+locosync_requests_total{host="http://127.0.0.1:8080"} 3
+# HELP locosync_responses_total HTTP responses by status class.
+# TYPE locosync_responses_total counter
+locosync_responses_total{host="http://127.0.0.1:8080",class="1xx"} 0
+locosync_responses_total{host="http://127.0.0.1:8080",class="2xx"} 1
+locosync_responses_total{host="http://127.0.0.1:8080",class="3xx"} 0
+locosync_responses_total{host="http://127.0.0.1:8080",class="4xx"} 1
+locosync_responses_total{host="http://127.0.0.1:8080",class="5xx"} 0
+# HELP locosync_transport_errors_total Transfers that failed without an HTTP status.
+# TYPE locosync_transport_errors_total counter
+locosync_transport_errors_total{host="http://127.0.0.1:8080"} 1
+# HELP locosync_received_bytes_total Response body bytes received on the wire.
+# TYPE locosync_received_bytes_total counter
+locosync_received_bytes_total{host="http://127.0.0.1:8080"} 1010
+# HELP locosync_phase_seconds_total Time spent in each request phase.
+# TYPE locosync_phase_seconds_total counter
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="queue"} 0.250000
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="dns"} 0.375000
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="connect"} 0.187500
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="tls"} 0.000000
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="ttfb"} 0.093750
+locosync_phase_seconds_total{host="http://127.0.0.1:8080",phase="transfer"} 0.750000
+# HELP locosync_request_duration_seconds Request latency (queue + transfer).
+# TYPE locosync_request_duration_seconds histogram
+)";
+    for (std::size_t b = 0; b < std::size(kLatencyBucketBounds); ++b) {
+        const int cumulative = b < 73 ? 1 : b < 75 ? 2 : 3;
+        expected += "locosync_request_duration_seconds_bucket{host=\"http://127.0.0.1:8080\",le=\"" +
+                    std::string(kLatencyBucketBounds[b]) + "\"} " + std::to_string(cumulative) + "\n";
+    }
+    expected += R"(locosync_request_duration_seconds_bucket{host="http://127.0.0.1:8080",le="+Inf"} 3
+locosync_request_duration_seconds_sum{host="http://127.0.0.1:8080"} 1.750000
+locosync_request_duration_seconds_count{host="http://127.0.0.1:8080"} 3
+)";
+    CHECK_EQ(registry.prometheus(), expected);
+
+    // Valores de label com \, " e quebra de linha são escapados
+    locosync::detail::MetricsRegistry escaped;
+    escaped.record("http://a\"b\\c\nd", metric_sample(200, 1, 0.0, 0.0));
+    CHECK(escaped.prometheus().find("locosync_requests_total{host=\"http://a\\\"b\\\\c\\nd\"} 1\n") !=
+          std::string::npos);
+}
+
+// --- CLIENT CONTRA O SERVIDOR EM LOOPBACK ---
+
+#ifdef LOCOSYNC_TEST_LOOPBACK
+
+using locosync::bench::LoopbackServer;
+
+locosync::Request get_request(const LoopbackServer& server, const std::string& path) {
+    locosync::Request r;
+    r.url = server.url(path);
+    return r;
+}
+
+TEST(threaded_engine_reuses_connections_per_handle) {
+    LoopbackServer server;
+    auto client = locosync::Client::create();
+
+    // Requisições simultâneas em várias threads, sem cache de conexões no
+    // CURLSH: cada handle do pool reaproveita a própria conexão
+    constexpr int kThreads = 8;
+    constexpr int kRounds = 25;
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kRounds; ++j) {
+                const auto res = client->request(get_request(server, "/bytes?size=2048")).get();
+                if (res.ok() && res.body.size() == 2048) ok.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    CHECK_EQ(ok.load(), kThreads * kRounds);
+    const auto stats = client->pool_stats();
+    CHECK(stats.hits >= static_cast<std::uint64_t>(kThreads * (kRounds - 1)));
+    CHECK(server.connections_accepted() <= stats.misses);
+}
+
+// Encodings que este build comprime e o cURL sabe decodificar
+std::vector<locosync::ContentEncoding> round_trip_encodings() {
+    using locosync::ContentEncoding;
+    const curl_version_info_data* curl = curl_version_info(CURLVERSION_NOW);
+    std::vector<ContentEncoding> out;
+    for (auto [encoding, feature] : {std::pair{ContentEncoding::Gzip, CURL_VERSION_LIBZ},
+                                     std::pair{ContentEncoding::Brotli, CURL_VERSION_BROTLI},
+                                     std::pair{ContentEncoding::Zstd, CURL_VERSION_ZSTD}}) {
+        if (locosync::detail::encoding_available(encoding) && (curl->features & feature)) out.push_back(encoding);
+    }
+    return out;
+}
+
+std::string compressible_payload() {
+    std::string payload;
+    for (int i = 0; payload.size() < 64 * 1024; ++i) {
+        payload += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\",\"tags\":[\"a\",\"b\"]},";
+    }
+    return payload;
+}
+
+TEST(compression_round_trip) {
+    const std::string payload = compressible_payload();
+    CHECK(!round_trip_encodings().empty());
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        for (auto encoding : round_trip_encodings()) {
+            LoopbackServer server;
+            locosync::ClientOptions options;
+            options.engine = engine;
+            options.compression.request_encoding = encoding;
+            auto client = locosync::Client::create(options);
+
+            // /echo devolve os bytes comprimidos com o mesmo Content-Encoding;
+            // o cURL descompacta a resposta
+            locosync::Request req = get_request(server, "/echo");
+            req.method = locosync::Method::PUT;
+            req.headers["Content-Type"] = "application/json";
+            req.body = payload;
+            const auto res = client->request(std::move(req)).get();
+            CHECK(res.ok());
+            CHECK(res.body == payload);
+            CHECK_EQ(res.header("Content-Encoding"), std::string_view(locosync::detail::encoding_token(encoding)));
+            CHECK(res.wire_bytes > 0);
+            CHECK(res.wire_bytes < payload.size() / 4);
+            CHECK_EQ(res.decoded_bytes, static_cast<std::uint64_t>(payload.size()));
+
+            // Sem Accept-Encoding o corpo chega como está na rede
+            locosync::ClientOptions raw_options = options;
+            raw_options.compression.accept_encoding = false;
+            auto raw_client = locosync::Client::create(raw_options);
+            locosync::Request raw = get_request(server, "/echo");
+            raw.method = locosync::Method::PUT;
+            raw.body = payload;
+            const auto compressed = raw_client->request(std::move(raw)).get();
+            CHECK(compressed.ok());
+            CHECK_EQ(compressed.wire_bytes, res.wire_bytes);
+            CHECK_EQ(compressed.decoded_bytes, compressed.wire_bytes);
+            CHECK_EQ(compressed.body.size(), static_cast<std::size_t>(compressed.wire_bytes));
+        }
+    }
+}
+
+// Guarda o que o interceptor viu; com `encoding` definido, escolhe o Content-Encoding
+struct EncodingProbe : locosync::Interceptor {
+    std::string encoding;
+    std::size_t body_size{0}; // lidos depois do future: o get() sincroniza
+    std::string seen_encoding;
+
+    void on_request(locosync::Request& req) override {
+        body_size = req.body.size();
+        auto it = req.headers.find("Content-Encoding");
+        seen_encoding = it == req.headers.end() ? "" : it->second;
+        if (!encoding.empty()) req.headers["Content-Encoding"] = encoding;
+    }
+};
+
+TEST(compression_runs_after_interceptors) {
+    const std::string payload = compressible_payload();
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        for (const char* chosen : {"", "identity"}) {
+            LoopbackServer server;
+            locosync::ClientOptions options;
+            options.engine = engine;
+            options.compression.request_encoding = locosync::ContentEncoding::Gzip;
+            auto client = locosync::Client::create(options);
+            auto probe = std::make_unique<EncodingProbe>();
+            probe->encoding = chosen;
+            EncodingProbe* seen = probe.get();
+            client->add_interceptor(std::move(probe));
+
+            locosync::Request req = get_request(server, "/echo");
+            req.method = locosync::Method::PUT;
+            req.body = payload;
+            const auto res = client->request(std::move(req)).get();
+            CHECK(res.ok());
+            CHECK(res.body == payload);
+            // O interceptor vê o corpo original, ainda sem Content-Encoding
+            CHECK_EQ(seen->body_size, payload.size());
+            CHECK_EQ(seen->seen_encoding, std::string());
+            if (*chosen) {
+                // Content-Encoding do interceptor: o corpo segue sem compressão
+                CHECK_EQ(res.header("Content-Encoding"), std::string_view("identity"));
+                CHECK_EQ(res.wire_bytes, static_cast<std::uint64_t>(payload.size()));
+            } else if (locosync::detail::encoding_available(locosync::ContentEncoding::Gzip)) {
+                CHECK_EQ(res.header("Content-Encoding"), std::string_view("gzip"));
+                CHECK(res.wire_bytes < payload.size());
+            }
+        }
+    }
+}
+
+TEST(coalesced_gets_share_one_transfer) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        options.coalesce_requests = true;
+        auto client = locosync::Client::create(options);
+
+        // O primeiro vira líder; os demais chegam enquanto ele espera o servidor
+        constexpr int kCallers = 16;
+        std::vector<std::future<locosync::Response>> futures;
+        for (int i = 0; i < kCallers; ++i) {
+            futures.push_back(client->request(get_request(server, "/bytes?size=100000&delay_ms=200")));
+        }
+        for (auto& f : futures) {
+            const auto res = f.get();
+            CHECK(res.ok());
+            CHECK_EQ(res.status_code, 200);
+            CHECK_EQ(res.body.size(), std::size_t{100000});
+            CHECK_EQ(res.header("Content-Length"), std::string_view("100000"));
+        }
+        CHECK_EQ(server.requests_served(), std::uint64_t{1});
+
+        // Terminado o voo, a chave sai do mapa: a próxima chamada vai à rede
+        CHECK(client->request(get_request(server, "/bytes?size=100000&delay_ms=200")).get().ok());
+        CHECK_EQ(server.requests_served(), std::uint64_t{2});
+    }
+}
+
+TEST(coalesced_followers_receive_leader_error) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        options.coalesce_requests = true;
+        auto client = locosync::Client::create(options);
+
+        // O timeout não entra na chave: os seguidores herdam a falha do líder
+        locosync::Request leader = get_request(server, "/bytes?size=64&delay_ms=400");
+        leader.timeout_ms = 100;
+        auto leader_future = client->request(std::move(leader));
+        std::vector<std::future<locosync::Response>> followers;
+        for (int i = 0; i < 8; ++i) {
+            followers.push_back(client->request(get_request(server, "/bytes?size=64&delay_ms=400")));
+        }
+
+        const auto failed = leader_future.get();
+        CHECK(!failed.ok());
+        CHECK_EQ(failed.error_message, std::string("Timeout was reached"));
+        for (auto& f : followers) {
+            const auto res = f.get();
+            CHECK(!res.ok());
+            CHECK_EQ(res.error_message, failed.error_message);
+            CHECK(res.body.empty());
+        }
+
+        // A falha não fica presa na chave: a chamada seguinte é um novo líder
+        const auto retry = client->request(get_request(server, "/bytes?size=64&delay_ms=400")).get();
+        CHECK(retry.ok());
+        CHECK_EQ(retry.body.size(), std::size_t{64});
+    }
+}
+
+// Reactor usado direto, sem Client: pool, arena e loop como em Client::submit.
+// O reactor é o último membro, então é destruído (e aborta o que está em voo)
+// antes do pool e da arena.
+struct ReactorHarness {
+    locosync::ClientOptions options;
+    locosync::detail::ConnectionPool pool{options.pool};
+    locosync::detail::TransferPool transfers;
+    std::optional<locosync::detail::Reactor> reactor{std::in_place, 1, options.pool};
+
+    std::future<locosync::Response> submit(locosync::Request req,
+                                           std::shared_ptr<std::atomic<bool>> cancel = nullptr) {
+        auto promise = std::make_shared<std::promise<locosync::Response>>();
+        auto future = promise->get_future();
+        locosync::detail::TransferPtr t = transfers.acquire();
+        t->request = std::move(req);
+        t->queued_at = std::chrono::steady_clock::now();
+        t->lease = pool.acquire(t->request.url, /*wait_for_slot=*/false);
+        t->cancel = std::move(cancel);
+        locosync::detail::configure(*t, options);
+        t->on_done = [promise](locosync::detail::Transfer& done) {
+            promise->set_value(std::move(done.response));
+        };
+        reactor->submit(std::move(t));
+        return future;
+    }
+};
+
+TEST(reactor_reuses_keep_alive_connection) {
+    LoopbackServer server;
+    ReactorHarness harness;
+    for (int i = 0; i < 20; ++i) {
+        const auto res = harness.submit(get_request(server, "/bytes?size=4096")).get();
+        CHECK(res.ok());
+        CHECK_EQ(res.body.size(), std::size_t{4096});
+    }
+    // Uma conexão só: o cache de conexões do multi handle a mantém entre requisições
+    CHECK_EQ(server.connections_accepted(), std::uint64_t{1});
+    CHECK_EQ(server.requests_served(), std::uint64_t{20});
+
+    // close=1: o servidor fecha e a próxima requisição abre outra conexão
+    CHECK(harness.submit(get_request(server, "/bytes?size=16&close=1")).get().ok());
+    CHECK(harness.submit(get_request(server, "/bytes?size=16")).get().ok());
+    CHECK_EQ(server.connections_accepted(), std::uint64_t{2});
+}
+
+TEST(reactor_cancels_only_flagged_transfer) {
+    LoopbackServer server;
+    ReactorHarness harness;
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    const auto start = std::chrono::steady_clock::now();
+    auto cancelled = harness.submit(get_request(server, "/bytes?size=64&delay_ms=5000"), cancel);
+    auto sibling = harness.submit(get_request(server, "/bytes?size=64&delay_ms=300"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    cancel->store(true);
+
+    const auto aborted = cancelled.get();
+    CHECK(!aborted.ok());
+    CHECK_EQ(aborted.error_message, std::string(curl_easy_strerror(CURLE_ABORTED_BY_CALLBACK)));
+    // O cURL consulta o progresso pelo menos uma vez por segundo
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2500));
+
+    const auto other = sibling.get();
+    CHECK(other.ok());
+    CHECK_EQ(other.body.size(), std::size_t{64});
+}
+
+TEST(reactor_destruction_aborts_in_flight) {
+    LoopbackServer server;
+    {
+        ReactorHarness harness;
+        std::vector<std::future<locosync::Response>> futures;
+        for (int i = 0; i < 5; ++i) futures.push_back(harness.submit(get_request(server, "/bytes?size=64&delay_ms=5000")));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // abort_all: cada on_done é chamado com o motivo, sem esperar o servidor
+        const auto start = std::chrono::steady_clock::now();
+        harness.reactor.reset();
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+        for (auto& f : futures) {
+            CHECK(f.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+            CHECK_EQ(f.get().error_message, std::string("Request cancelled: client destroyed."));
+        }
+    }
+
+    // O mesmo pelo Client com Engine::Reactor: os futures não ficam pendurados
+    locosync::ClientOptions options;
+    options.engine = locosync::Engine::Reactor;
+    auto client = locosync::Client::create(options);
+    std::vector<std::future<locosync::Response>> futures;
+    for (int i = 0; i < 5; ++i) futures.push_back(client->request(get_request(server, "/bytes?size=64&delay_ms=5000")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    client.reset();
+    for (auto& f : futures) {
+        CHECK(f.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+        CHECK_EQ(f.get().error_message, std::string("Request cancelled: client destroyed."));
+    }
+}
+
+// Tamanhos distintos por índice; os primeiros demoram mais, então terminam por último
+std::vector<locosync::Request> batch_requests(const LoopbackServer& server, std::size_t count) {
+    std::vector<locosync::Request> requests;
+    for (std::size_t i = 0; i < count; ++i) {
+        requests.push_back(get_request(server, "/bytes?size=" + std::to_string(100 + i) +
+                                                   "&delay_ms=" + std::to_string(10 * (count - i))));
+    }
+    return requests;
+}
+
+TEST(batch_results_keep_request_order) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        auto client = locosync::Client::create(options);
+
+        const auto results = client->batch(batch_requests(server, 20)).get();
+        CHECK_EQ(results.size(), std::size_t{20});
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            CHECK(results[i].ok());
+            CHECK_EQ(results[i].body.size(), 100 + i);
+        }
+
+        // batch_stream: ordem de término, com o índice original de cada resultado
+        auto stream = client->batch_stream(batch_requests(server, 20));
+        std::vector<bool> seen(20, false);
+        std::vector<std::size_t> order;
+        while (auto result = stream->next()) {
+            CHECK(!seen[result->index]);
+            seen[result->index] = true;
+            order.push_back(result->index);
+            CHECK_EQ(result->response.body.size(), 100 + result->index);
+        }
+        CHECK_EQ(order.size(), std::size_t{20});
+        CHECK(order.front() > order.back()); // os atrasos decrescem com o índice
+        CHECK(!client->batch({}).get().size());
+    }
+}
+
+TEST(batch_respects_concurrency_window) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        auto client = locosync::Client::create(options);
+
+        auto timed = [&](std::size_t window) {
+            std::vector<locosync::Request> requests;
+            for (int i = 0; i < 12; ++i) requests.push_back(get_request(server, "/bytes?size=32&delay_ms=200"));
+            locosync::BatchOptions batch_options;
+            batch_options.max_concurrency = window;
+            const auto start = std::chrono::steady_clock::now();
+            auto stream = client->batch_stream(std::move(requests), batch_options);
+            std::size_t count = 0;
+            while (auto result = stream->next()) count += result->response.ok() ? 1 : 0;
+            CHECK_EQ(count, std::size_t{12});
+            return std::chrono::steady_clock::now() - start;
+        };
+
+        // Janela de 3: quatro ondas de 200 ms; nunca mais rápido que isso
+        CHECK(timed(3) >= std::chrono::milliseconds(780));
+        // Janela cobrindo o lote: tudo em voo ao mesmo tempo
+        CHECK(timed(12) < std::chrono::milliseconds(700));
+    }
+}
+
+TEST(batch_failure_midway_does_not_stop_the_rest) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        auto client = locosync::Client::create(options);
+
+        auto requests = batch_requests(server, 10);
+        requests[3].timeout_ms = 20;                  // estoura o timeout
+        requests[5].url = server.url("/inexistente"); // 404: resposta, não erro de transporte
+        requests[7].url = "http://127.0.0.1:1/";      // conexão recusada
+        locosync::BatchOptions batch_options;
+        batch_options.max_concurrency = 2;
+
+        const auto results = client->batch(std::move(requests), batch_options).get();
+        CHECK_EQ(results.size(), std::size_t{10});
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (i == 3) {
+                CHECK_EQ(results[i].error_message, std::string("Timeout was reached"));
+            } else if (i == 5) {
+                CHECK_EQ(results[i].status_code, 404);
+                CHECK(results[i].error_message.empty());
+            } else if (i == 7) {
+                CHECK(!results[i].error_message.empty());
+                CHECK_EQ(results[i].status_code, 0);
+            } else {
+                CHECK(results[i].ok());
+                CHECK_EQ(results[i].body.size(), 100 + i);
+            }
+        }
+    }
+}
+
+locosync::Task<std::size_t> fetch_size(locosync::Client& client, std::string url) {
+    auto res = co_await client.co_get(url);
+    if (!res.ok()) throw std::runtime_error("falhou: " + url);
+    co_return res.body.size();
+}
+
+TEST(when_all_keeps_order_and_propagates_failure) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        auto client = locosync::Client::create(options);
+        locosync::Executor executor;
+
+        // Concorrentes: 8 x 200 ms terminam bem antes de 1,6 s
+        std::vector<locosync::Task<std::size_t>> tasks;
+        for (std::size_t i = 0; i < 8; ++i) {
+            tasks.push_back(fetch_size(*client, server.url("/bytes?delay_ms=200&size=" + std::to_string(10 + i))));
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const auto sizes = executor.run(locosync::when_all(std::move(tasks)));
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+        CHECK_EQ(sizes.size(), std::size_t{8});
+        for (std::size_t i = 0; i < sizes.size(); ++i) CHECK_EQ(sizes[i], 10 + i);
+
+        // Uma tarefa falha no meio: a exceção chega ao chamador depois que todas terminam
+        std::vector<locosync::Task<std::size_t>> mixed;
+        for (std::size_t i = 0; i < 6; ++i) {
+            mixed.push_back(fetch_size(*client, server.url(i == 2 ? "/inexistente" : "/bytes?size=8&delay_ms=50")));
+        }
+        bool thrown = false;
+        try {
+            executor.run(locosync::when_all(std::move(mixed)));
+        } catch (const std::runtime_error& e) {
+            thrown = std::string(e.what()).find("/inexistente") != std::string::npos;
+        }
+        CHECK(thrown);
+    }
+}
+
+TEST(adaptive_timeout_recovers_when_host_slows_down) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        options.adaptive_timeouts.enabled = true;
+        options.adaptive_timeouts.min_samples = 20;
+        options.adaptive_timeouts.min_timeout = std::chrono::milliseconds(50);
+        auto client = locosync::Client::create(options);
+
+        // Histórico rápido: o timeout encolhe para o mínimo (50 ms)
+        for (int i = 0; i < 60; ++i) {
+            CHECK(client->request(get_request(server, "/bytes?size=16")).get().ok());
+        }
+
+        // O host passa a levar 300 ms: as primeiras tentativas estouram o
+        // timeout encurtado, depois ele cresce e as requisições voltam a passar
+        int timeouts = 0;
+        int consecutive_ok = 0;
+        for (int i = 0; i < 12 && consecutive_ok < 3; ++i) {
+            locosync::Request slow = get_request(server, "/bytes?size=16&delay_ms=300");
+            slow.timeout_ms = 5000;
+            const auto res = client->request(std::move(slow)).get();
+            if (res.ok()) {
+                ++consecutive_ok;
+            } else {
+                CHECK_EQ(res.error_message, std::string("Timeout was reached"));
+                ++timeouts;
+                consecutive_ok = 0;
+            }
+        }
+        CHECK(timeouts >= 1);
+        CHECK(timeouts <= 4);
+        CHECK_EQ(consecutive_ok, 3);
+    }
+}
+
+TEST(hedged_upload_sends_full_body) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        options.hedging.enabled = true;
+        options.hedging.min_samples = 5;
+        options.hedging.min_delay = std::chrono::milliseconds(5);
+        options.hedging.budget_burst = 100.0;
+        auto client = locosync::Client::create(options);
+
+        const std::string payload(256 * 1024, 'u');
+        const std::string expected = "{\"received\":" + std::to_string(payload.size()) + "}";
+        auto put = [&](const std::string& path) {
+            locosync::Request r = get_request(server, path);
+            r.method = locosync::Method::PUT;
+            r.headers["Content-Type"] = "application/octet-stream";
+            r.body = payload;
+            return client->request(std::move(r)).get();
+        };
+
+        for (int i = 0; i < 10; ++i) CHECK_EQ(put("/upload").body, expected);
+        // Respostas lentas: o hedge sai e as duas tentativas mandam o corpo inteiro
+        for (int i = 0; i < 5; ++i) {
+            const auto res = put("/upload?delay_ms=100");
+            CHECK(res.ok());
+            CHECK_EQ(res.body, expected);
+        }
+        CHECK(client->hedge_stats().hedged >= 1);
+
+        // Perdedoras canceladas não aparecem como erro de transporte
+        const std::string metrics = client->prometheus_metrics();
+        const std::string errors = "locosync_transport_errors_total{host=\"" + server.url("") + "\"} ";
+        CHECK(metrics.find(errors + "0\n") != std::string::npos);
+    }
+}
+
+TEST(hedge_losers_stay_out_of_metrics) {
+    for (auto engine : {locosync::Engine::Threaded, locosync::Engine::Reactor}) {
+        LoopbackServer server;
+        locosync::ClientOptions options;
+        options.engine = engine;
+        options.hedging.enabled = true;
+        options.hedging.min_samples = 5;
+        options.hedging.min_delay = std::chrono::milliseconds(50);
+        options.hedging.max_delay = std::chrono::milliseconds(50);
+        options.hedging.budget_burst = 100.0;
+        auto client = locosync::Client::create(options);
+
+        for (int i = 0; i < 10; ++i) CHECK(client->request(get_request(server, "/bytes?size=64")).get().ok());
+        // O hedge sai depois de 50 ms; a tentativa que perde é cancelada
+        for (int i = 0; i < 5; ++i) {
+            CHECK(client->request(get_request(server, "/bytes?size=64&delay_ms=300")).get().ok());
+        }
+        CHECK(client->hedge_stats().hedged >= 1);
+
+        // Uma amostra por requisição lógica, mesmo com tentativas extras
+        const std::string metrics = client->prometheus_metrics();
+        const std::string host = "{host=\"" + server.url("") + "\"";
+        CHECK(metrics.find("locosync_requests_total" + host + "} 15\n") != std::string::npos);
+        CHECK(metrics.find("locosync_responses_total" + host + ",class=\"2xx\"} 15\n") != std::string::npos);
+        CHECK(metrics.find("locosync_transport_errors_total" + host + "} 0\n") != std::string::npos);
+        CHECK(metrics.find("locosync_request_duration_seconds_count" + host + "} 15\n") != std::string::npos);
+        CHECK(metrics.find("locosync_request_duration_seconds_bucket" + host + ",le=\"+Inf\"} 15\n") != std::string::npos);
+    }
+}
+
+#endif
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+    for (const auto& test : registry()) {
+        if (filter && !std::strstr(test.name, filter)) continue;
+        const int before = failures;
+        test.run();
+        ++ran;
+        std::printf("%-48s %s\n", test.name, failures == before ? "ok" : "FALHOU");
+    }
+    std::printf("%d testes, %d falhas\n", ran, failures);
+    return failures == 0 && ran > 0 ? 0 : 1;
+}